@@ -0,0 +1,165 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/SlowMotion.h"
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t BACKEND_ROUNDS = 20000;
+
+        const char* BackendName(Config::SlowdownBackend a_backend) {
+            return a_backend == Config::SlowdownBackend::kSpeedMult ? "speedmult" : "spell";
+        }
+
+        // Every NPC draws, redraws at another tier and releases, one step per frame
+        void BenchBowCycle(Config::SlowdownBackend a_backend) {
+            auto& fixture = Fixture::Get();
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            slowMgr->SetBackend(a_backend);
+            fixture.Reset();
+
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < BACKEND_ROUNDS; ++round) {
+                for (auto npc : fixture.npcs) {
+                    slowMgr->ApplySlowdown(npc, SlowType::Bow, 20.0f);
+                }
+                fixture.Frame();
+                for (auto npc : fixture.npcs) {
+                    slowMgr->ApplySlowdown(npc, SlowType::Bow, 90.0f);
+                }
+                fixture.Frame();
+                for (auto npc : fixture.npcs) {
+                    slowMgr->RemoveSlowdown(npc, SlowType::Bow);
+                }
+                fixture.Frame();
+            }
+            auto elapsed = Clock::now() - start;
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "bow draw/redraw/release/%s", BackendName(a_backend));
+            PrintResult(name, BACKEND_ROUNDS * fixture.npcs.size() * 3, elapsed, EngineCalls());
+        }
+
+        // Left hand, right hand (dual), release both, one step per frame
+        void BenchDualCastCycle(Config::SlowdownBackend a_backend) {
+            auto& fixture = Fixture::Get();
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            slowMgr->SetBackend(a_backend);
+            fixture.Reset();
+
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < BACKEND_ROUNDS; ++round) {
+                for (auto npc : fixture.npcs) {
+                    slowMgr->ApplySlowdown(npc, SlowType::CastLeft, 50.0f);
+                }
+                fixture.Frame();
+                for (auto npc : fixture.npcs) {
+                    slowMgr->ApplySlowdown(npc, SlowType::CastRight, 50.0f);
+                }
+                fixture.Frame();
+                for (auto npc : fixture.npcs) {
+                    slowMgr->RemoveSlowdown(npc, SlowType::CastLeft);
+                    slowMgr->RemoveSlowdown(npc, SlowType::CastRight);
+                }
+                fixture.Frame();
+            }
+            auto elapsed = Clock::now() - start;
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "cast/dual cast/release/%s", BackendName(a_backend));
+            PrintResult(name, BACKEND_ROUNDS * fixture.npcs.size() * 3, elapsed, EngineCalls());
+        }
+
+        // After a bow and a dual cast overlap and end, SpeedMult must be back to its exact
+        // starting value and no effect may be left on the actor
+        bool CheckRestore(Config::SlowdownBackend a_backend) {
+            auto& fixture = Fixture::Get();
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            slowMgr->SetBackend(a_backend);
+            fixture.Reset();
+
+            auto npc = fixture.npcs.front();
+            auto avOwner = npc->AsActorValueOwner();
+            auto before = avOwner->GetActorValue(RE::ActorValue::kSpeedMult);
+
+            float slowest = before;
+            slowMgr->ApplySlowdown(npc, SlowType::Bow, 33.0f);
+            fixture.Frame();
+            slowMgr->ApplySlowdown(npc, SlowType::CastLeft, 61.0f);
+            slowMgr->ApplySlowdown(npc, SlowType::CastRight, 61.0f);
+            fixture.Frame();
+            if (a_backend == Config::SlowdownBackend::kSpeedMult) {
+                slowest = avOwner->GetActorValue(RE::ActorValue::kSpeedMult);
+            }
+            slowMgr->ApplySlowdown(npc, SlowType::Crossbow, 88.0f);
+            fixture.Frame();
+            slowMgr->RemoveSlowdown(npc, SlowType::CastRight);
+            fixture.Frame();
+            slowMgr->ClearAllSlowdowns(npc);
+            fixture.Frame();
+
+            auto after = avOwner->GetActorValue(RE::ActorValue::kSpeedMult);
+            auto leftover = npc->GetMagicTarget()->activeEffects.size();
+            bool restored = after == before && leftover == 0 && (a_backend == Config::SlowdownBackend::kSpell || slowest < before);
+            std::printf("    %s: SpeedMult %.6f -> %.6f -> %.6f, %zu effects left: %s\n", BackendName(a_backend),
+                before, slowest, after, leftover, restored ? "ok" : "MISMATCH");
+            return restored;
+        }
+
+        // A load: kPreLoadGame clears through the backend while the old actors exist, and
+        // whatever is tracked by kPostLoadGame is dropped without touching the new ones
+        bool CheckLoad(Config::SlowdownBackend a_backend) {
+            auto& fixture = Fixture::Get();
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            slowMgr->SetBackend(a_backend);
+            fixture.Reset();
+
+            auto npc = fixture.npcs.front();
+            auto avOwner = npc->AsActorValueOwner();
+            auto before = avOwner->GetActorValue(RE::ActorValue::kSpeedMult);
+            slowMgr->ApplySlowdown(npc, SlowType::Bow, 33.0f);
+            fixture.Frame();
+            slowMgr->ClearAll();
+            bool cleared = avOwner->GetActorValue(RE::ActorValue::kSpeedMult) == before && npc->GetMagicTarget()->activeEffects.empty();
+
+            // Queued between the two messages
+            slowMgr->ApplySlowdown(fixture.npcs.back(), SlowType::CastLeft, 50.0f);
+            RE::Mock::ResetEngineCallCounters();
+            slowMgr->ForgetAll();
+            fixture.Frame();
+            bool forgotten = EngineCalls() == 0 && !slowMgr->IsActorSlowed(fixture.npcs.back());
+
+            bool ok = cleared && forgotten;
+            std::printf("    %s: load clears before and forgets after, no engine calls after: %s\n", BackendName(a_backend),
+                ok ? "ok" : "MISMATCH");
+            return ok;
+        }
+    }
+
+    bool RunBackendBenchmarks() {
+        constexpr Config::SlowdownBackend backends[] = {
+            Config::SlowdownBackend::kSpell,
+            Config::SlowdownBackend::kSpeedMult,
+        };
+
+        auto slowMgr = SlowMotionManager::GetSingleton();
+        auto original = slowMgr->GetBackend();
+
+        PrintHeader("Slowdown backends");
+        for (auto backend : backends) {
+            BenchBowCycle(backend);
+        }
+        for (auto backend : backends) {
+            BenchDualCastCycle(backend);
+        }
+
+        bool passed = true;
+        for (auto backend : backends) {
+            passed &= CheckRestore(backend);
+            passed &= CheckLoad(backend);
+        }
+
+        slowMgr->SetBackend(original);
+        Fixture::Get().Reset();
+        return passed;
+    }
+}
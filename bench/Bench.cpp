@@ -0,0 +1,51 @@
+#include "BenchHarness.h"
+
+#include <cstring>
+
+// siga_bench [group...]
+// Runs every benchmark group, or only those named on the command line.
+// Exits non-zero if any group's checks failed.
+int main(int argc, char** argv) {
+    // Benchmarks measure the cost of the log calls, not of writing them
+    spdlog::set_level(spdlog::level::info);
+    spdlog::set_pattern("[%H:%M:%S] [%l] %v");
+
+    struct Group {
+        const char* name;
+        bool (*run)();
+    };
+
+    constexpr Group groups[] = {
+        { "core", SIGA::Bench::RunCoreBenchmarks },
+        { "queue", SIGA::Bench::RunQueueBenchmarks },
+        { "tags", SIGA::Bench::RunTagBenchmarks },
+        { "combat", SIGA::Bench::RunCombatBenchmarks },
+        { "player", SIGA::Bench::RunPlayerBenchmarks },
+        { "weapons", SIGA::Bench::RunWeaponBenchmarks },
+        { "skills", SIGA::Bench::RunSkillBenchmarks },
+        { "spells", SIGA::Bench::RunSpellBenchmarks },
+        { "timers", SIGA::Bench::RunTimerBenchmarks },
+        { "ledger", SIGA::Bench::RunLedgerBenchmarks },
+        { "slots", SIGA::Bench::RunSlotBenchmarks },
+        { "backend", SIGA::Bench::RunBackendBenchmarks },
+        { "config", SIGA::Bench::RunConfigBenchmarks },
+        { "reload", SIGA::Bench::RunReloadBenchmarks },
+        { "log", SIGA::Bench::RunLogBenchmarks },
+        { "trace", SIGA::Bench::RunTraceBenchmarks },
+        { "metrics", SIGA::Bench::RunMetricsBenchmarks },
+        { "locks", SIGA::Bench::RunLockBenchmarks },
+    };
+
+    bool passed = true;
+    for (auto& group : groups) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            selected |= std::strcmp(argv[i], group.name) == 0;
+        }
+        if (selected) {
+            passed &= group.run();
+        }
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+#include "BenchFixture.h"
+#include "SIGA/CombatEventHandler.h"
+#include "SIGA/Config.h"
+#include "SIGA/SlowMotion.h"
+#include "SIGA/TagClassifier.h"
+
+#include <random>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t NPC_COUNT = 32;
+
+        // Tags a combat actor emits constantly that SIGA does not care about
+        constexpr const char* MISS_TAGS[] = {
+            "FootLeft", "FootRight", "FootSprintLeft", "FootSprintRight",
+            "tailCombatIdle", "tailCombatLocomotion", "IdleStop", "SoundPlay",
+            "weaponSwing", "weaponLeftSwing", "preHitFrame", "HitFrame",
+            "attackStart", "attackPowerStartInPlace", "MCO_WinOpen", "MCO_WinClose",
+            "bowDrawStart", "arrowAttach", "BowZoomStop", "CastOKStart",
+            "MRh_SpellFire_Event", "MLh_SpellFire_Event", "BeginWeaponDraw", "weaponDraw",
+            "AnimObjLoad", "AnimObjDraw", "TDM_Turn_180", "blockStartOut",
+        };
+    }
+
+    Fixture& Fixture::Get() {
+        static Fixture fixture;
+        return fixture;
+    }
+
+    Fixture::Fixture() {
+        auto settings = *Config::GetSingleton()->GetSnapshot();
+        settings.applyToNPCs = true;
+        auto config = Config::GetSingleton()->Publish(std::move(settings));
+
+        auto dataHandler = RE::TESDataHandler::GetSingleton();
+        auto registerDebuff = [&](RE::FormID a_localID, const char* a_name) {
+            auto spell = MakeSpell(0xFE000000 | a_localID, a_name, RE::ActorValue::kAlteration, RE::ActorValue::kSpeedMult);
+            dataHandler->RegisterPluginForm(spell, a_localID, config->pluginName);
+        };
+        registerDebuff(config->bowDebuffSpellID, "SIGA Bow Debuff");
+        registerDebuff(config->castingDebuffSpellID, "SIGA Casting Debuff");
+        registerDebuff(config->dualCastDebuffSpellID, "SIGA Dual Cast Debuff");
+        registerDebuff(config->crossbowDebuffSpellID, "SIGA Crossbow Debuff");
+
+        destructionSpell = MakeSpell(0x0001C789, "Flames", RE::ActorValue::kDestruction, RE::ActorValue::kNone);
+        unschooledSpell = MakeSpell(0x0001C78A, "Unschooled", RE::ActorValue::kNone, RE::ActorValue::kNone);
+
+        auto& bowForm = forms.emplace_back(std::make_unique<RE::TESObjectWEAP>());
+        bow = static_cast<RE::TESObjectWEAP*>(bowForm.get());
+        bow->formID = 0x00012EB6;
+        bow->weaponType = RE::WEAPON_TYPE::kBow;
+
+        auto& crossbowForm = forms.emplace_back(std::make_unique<RE::TESObjectWEAP>());
+        crossbow = static_cast<RE::TESObjectWEAP*>(crossbowForm.get());
+        crossbow->formID = 0x000F1AC1;
+        crossbow->weaponType = RE::WEAPON_TYPE::kCrossbow;
+
+        auto setupActor = [&](RE::Actor* a_actor, std::size_t a_index) {
+            auto avOwner = a_actor->AsActorValueOwner();
+            auto skill = static_cast<float>(15 + (a_index * 17) % 85);
+            avOwner->SetValue(RE::ActorValue::kArchery, skill);
+            avOwner->SetValue(RE::ActorValue::kDestruction, skill);
+            avOwner->SetValue(RE::ActorValue::kRestoration, skill);
+            avOwner->SetValue(RE::ActorValue::kAlteration, skill);
+            avOwner->SetValue(RE::ActorValue::kConjuration, skill);
+            avOwner->SetValue(RE::ActorValue::kIllusion, skill);
+            avOwner->SetValue(RE::ActorValue::kSpeedMult, 100.0f);
+
+            auto& spells = a_actor->GetActorRuntimeData().selectedSpells;
+            spells[RE::Actor::SlotTypes::kLeftHand] = destructionSpell;
+            spells[RE::Actor::SlotTypes::kRightHand] = (a_index % 3 == 0) ? unschooledSpell : destructionSpell;
+
+            a_actor->equippedRight = (a_index % 4 == 0) ? crossbow : bow;
+            a_actor->inCombat = true;
+            RE::TESForm::RegisterForm(a_actor);
+        };
+
+        player = RE::PlayerCharacter::GetSingleton();
+        player->fullName = "Player";
+        setupActor(player, 0);
+
+        for (std::size_t i = 0; i < NPC_COUNT; ++i) {
+            auto& form = forms.emplace_back(std::make_unique<RE::Actor>());
+            auto npc = static_cast<RE::Actor*>(form.get());
+            npc->formID = 0x0001A000 + static_cast<RE::FormID>(i);
+            npc->fullName = "Bandit " + std::to_string(i);
+            setupActor(npc, i + 1);
+            npcs.push_back(npc);
+        }
+
+        // NPCs enter combat the way the game reports it, so ProcessEvent sees them as eligible
+        for (auto npc : npcs) {
+            RE::TESCombatEvent combat{ npc, player, RE::ACTOR_COMBAT_STATE::kCombat };
+            CombatEventHandler::GetSingleton()->ProcessEvent(&combat, nullptr);
+        }
+
+        if (!SlowMotionManager::GetSingleton()->Initialize()) {
+            std::fprintf(stderr, "SlowMotionManager failed to initialize against the mock data handler\n");
+        }
+        TagClassifier::GetSingleton()->Initialize();
+    }
+
+    RE::SpellItem* Fixture::MakeSpell(RE::FormID a_formID, const char* a_name, RE::ActorValue a_school, RE::ActorValue a_primaryAV) {
+        auto& baseEffect = baseEffects.emplace_back(std::make_unique<RE::EffectSetting>());
+        baseEffect->data.primaryAV = a_primaryAV;
+
+        auto& effect = effects.emplace_back(std::make_unique<RE::Effect>());
+        effect->baseEffect = baseEffect.get();
+        effect->effectItem.magnitude = 50.0f;
+
+        auto& form = forms.emplace_back(std::make_unique<RE::SpellItem>());
+        auto spell = static_cast<RE::SpellItem*>(form.get());
+        spell->formID = a_formID;
+        spell->fullName = a_name;
+        spell->associatedSkill = a_school;
+        spell->effects.push_back(effect.get());
+        RE::TESForm::RegisterForm(spell);
+        RE::TESDataHandler::GetSingleton()->GetFormArray<RE::SpellItem>().push_back(spell);
+        return spell;
+    }
+
+    std::vector<RE::BSAnimationGraphEvent> Fixture::MakeEventStream(std::size_t a_count) const {
+        std::vector<const RE::Actor*> actors{ player };
+        actors.insert(actors.end(), npcs.begin(), npcs.end());
+
+        // Per actor: 0 = idle, 1 = bow drawn, 2 = casting
+        std::vector<int> actorState(actors.size(), 0);
+
+        std::mt19937 rng(0x5164u);
+        std::uniform_int_distribution<std::size_t> pickActor(0, actors.size() - 1);
+        std::uniform_int_distribution<std::size_t> pickMiss(0, std::size(MISS_TAGS) - 1);
+        std::uniform_int_distribution<int> roll(0, 99);
+
+        std::vector<RE::BSAnimationGraphEvent> stream;
+        stream.reserve(a_count);
+        for (std::size_t i = 0; i < a_count; ++i) {
+            auto index = pickActor(rng);
+            auto actor = actors[index];
+            auto& state = actorState[index];
+
+            const char* tag = MISS_TAGS[pickMiss(rng)];
+            auto dice = roll(rng);
+            if (dice < 3) {
+                switch (state) {
+                case 0:
+                    tag = (dice == 0) ? "BowDrawn" : (dice == 1 ? "BeginCastLeft" : "BeginCastRight");
+                    state = (dice == 0) ? 1 : 2;
+                    break;
+                case 1:
+                    tag = "bowRelease";
+                    state = 0;
+                    break;
+                default:
+                    tag = (dice == 0) ? "InterruptCast" : "CastStop";
+                    state = 0;
+                    break;
+                }
+            }
+            else if (dice == 3) {
+                tag = "attackStop";
+            }
+
+            stream.push_back(RE::BSAnimationGraphEvent{ tag, actor, {} });
+        }
+        return stream;
+    }
+
+    void Fixture::Reset() {
+        Frame();
+        SlowMotionManager::GetSingleton()->ClearAll();
+        SlowMotionManager::GetSingleton()->ResetCoalescingStats();
+        RE::Mock::ResetEngineCallCounters();
+    }
+
+    void Fixture::Frame() {
+        SKSE::Mock::RunQueuedTasks();
+    }
+
+    std::uint64_t EngineCalls() {
+        auto& counters = RE::Mock::GetEngineCallCounters();
+        return counters.castSpellImmediate.load(std::memory_order_relaxed) +
+            counters.dispelEffect.load(std::memory_order_relaxed) +
+            counters.actorValueMods.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace SIGA::Bench {
+    // A small fake world: the four debuff spells registered under the plugin
+    // name from Config, a player, and a crowd of NPCs in combat.
+    class Fixture {
+    public:
+        static Fixture& Get();
+
+        // Reset engine call counters and drop any slowdown state left by a previous benchmark
+        void Reset();
+
+        // End of frame on the main thread: runs queued SKSE tasks such as the slowdown flush
+        void Frame();
+
+        // A deterministic animation event stream over the player and NPCs: mostly
+        // footsteps, idles and attack frames, with the occasional draw/cast pair
+        [[nodiscard]] std::vector<RE::BSAnimationGraphEvent> MakeEventStream(std::size_t a_count) const;
+
+        RE::PlayerCharacter* player = nullptr;
+        std::vector<RE::Actor*> npcs;
+
+        RE::TESObjectWEAP* bow = nullptr;
+        RE::TESObjectWEAP* crossbow = nullptr;
+        RE::SpellItem* destructionSpell = nullptr;
+        RE::SpellItem* unschooledSpell = nullptr;
+
+    private:
+        Fixture();
+
+        std::vector<std::unique_ptr<RE::TESForm>> forms;
+        std::vector<std::unique_ptr<RE::EffectSetting>> baseEffects;
+        std::vector<std::unique_ptr<RE::Effect>> effects;
+
+        RE::SpellItem* MakeSpell(RE::FormID a_formID, const char* a_name, RE::ActorValue a_school, RE::ActorValue a_primaryAV);
+    };
+
+    std::uint64_t EngineCalls();
+}
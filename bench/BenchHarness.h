@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace SIGA::Bench {
+    using Clock = std::chrono::steady_clock;
+
+    // Keeps the optimizer from discarding a value computed in a benchmark loop
+    template <class T>
+    inline void DoNotOptimize(const T& a_value) {
+        asm volatile("" : : "r,m"(a_value) : "memory");
+    }
+
+    inline void PrintHeader(std::string_view a_group) {
+        std::printf("\n== %.*s\n", static_cast<int>(a_group.size()), a_group.data());
+        std::printf("%-48s %12s %12s %14s\n", "benchmark", "ops", "ns/op", "engine/op");
+    }
+
+    inline void PrintResult(std::string_view a_name, std::uint64_t a_ops, Clock::duration a_elapsed, std::uint64_t a_engineCalls) {
+        auto ns = std::chrono::duration<double, std::nano>(a_elapsed).count();
+        std::printf("%-48.*s %12llu %12.2f %14.3f\n",
+            static_cast<int>(a_name.size()), a_name.data(),
+            static_cast<unsigned long long>(a_ops),
+            a_ops ? ns / static_cast<double>(a_ops) : 0.0,
+            a_ops ? static_cast<double>(a_engineCalls) / static_cast<double>(a_ops) : 0.0);
+    }
+
+    // Benchmark groups, one per source file; each prints its own header and
+    // returns false if one of its checks failed
+    bool RunCoreBenchmarks();
+    bool RunQueueBenchmarks();
+    bool RunCombatBenchmarks();
+    bool RunPlayerBenchmarks();
+    bool RunWeaponBenchmarks();
+    bool RunSkillBenchmarks();
+    bool RunSlotBenchmarks();
+    bool RunSpellBenchmarks();
+    bool RunTimerBenchmarks();
+    bool RunTagBenchmarks();
+    bool RunLedgerBenchmarks();
+    bool RunBackendBenchmarks();
+    bool RunConfigBenchmarks();
+    bool RunReloadBenchmarks();
+    bool RunLogBenchmarks();
+    bool RunTraceBenchmarks();
+    bool RunMetricsBenchmarks();
+    bool RunLockBenchmarks();
+
+    // In its own file, built with trace and debug logging compiled out
+    std::size_t RunStrippedDebugCalls(const std::vector<RE::Actor*>& a_actors, std::size_t a_rounds);
+}
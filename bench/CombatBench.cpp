@@ -0,0 +1,149 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/AnimationHandler.h"
+#include "SIGA/CombatEventHandler.h"
+#include "SIGA/SlowMotion.h"
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t BYSTANDER_COUNT = 480;
+        constexpr std::size_t AMBIENT_EVENTS = 1 << 20;
+
+        void SendCombatState(RE::Actor* a_actor, RE::ACTOR_COMBAT_STATE a_state) {
+            RE::TESCombatEvent event{ a_actor, nullptr, a_state };
+            CombatEventHandler::GetSingleton()->ProcessEvent(&event, nullptr);
+        }
+
+        std::size_t CountSinks(const std::vector<RE::Actor*>& a_actors) {
+            std::size_t sinks = 0;
+            for (auto actor : a_actors) {
+                sinks += actor->animationGraphEventSource.GetSinkCount();
+            }
+            return sinks;
+        }
+
+        // Footsteps and idles from everyone in the cell, through each actor's own graph
+        // source as the engine sends them
+        void BenchAmbientEvents(std::string_view a_name, const std::vector<RE::Actor*>& a_actors) {
+            std::vector<RE::BSAnimationGraphEvent> events;
+            events.reserve(a_actors.size());
+            for (std::size_t i = 0; i < a_actors.size(); ++i) {
+                events.push_back(RE::BSAnimationGraphEvent{ i % 2 ? "FootLeft" : "IdleStop", a_actors[i], {} });
+            }
+
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < AMBIENT_EVENTS; ++i) {
+                auto index = i % a_actors.size();
+                a_actors[index]->animationGraphEventSource.SendEvent(&events[index]);
+            }
+            PrintResult(a_name, AMBIENT_EVENTS, Clock::now() - start, 0);
+        }
+    }
+
+    bool RunCombatBenchmarks() {
+        auto& fixture = Fixture::Get();
+        fixture.Reset();
+
+        auto handler = CombatEventHandler::GetSingleton();
+        auto slowMgr = SlowMotionManager::GetSingleton();
+
+        // Everyone fought at some point in the session: the fixture's NPCs and a crowd more
+        std::vector<std::unique_ptr<RE::Actor>> bystanders;
+        std::vector<RE::Actor*> actors = fixture.npcs;
+        for (std::size_t i = 0; i < BYSTANDER_COUNT; ++i) {
+            auto& actor = bystanders.emplace_back(std::make_unique<RE::Actor>());
+            actor->formID = 0x0002B000 + static_cast<RE::FormID>(i);
+            actor->fullName = "Guard " + std::to_string(i);
+            RE::TESForm::RegisterForm(actor.get());
+            actors.push_back(actor.get());
+        }
+
+        PrintHeader("Combat sinks");
+
+        auto start = Clock::now();
+        for (auto actor : actors) {
+            actor->inCombat = true;
+            SendCombatState(actor, RE::ACTOR_COMBAT_STATE::kCombat);
+        }
+        PrintResult("Combat start (registers sink)", actors.size(), Clock::now() - start, 0);
+
+        // Leftover slowdowns on the first few, and a search that must keep its sink
+        for (std::size_t i = 0; i < 8; ++i) {
+            slowMgr->ApplySlowdown(actors[i], SlowType::Bow, 50.0f);
+        }
+        fixture.Frame();
+        SendCombatState(actors[0], RE::ACTOR_COMBAT_STATE::kSearching);
+        SendCombatState(fixture.player, RE::ACTOR_COMBAT_STATE::kNone);
+
+        bool registered = handler->GetRegisteredCount() == actors.size() && CountSinks(actors) == actors.size();
+        std::printf("    %zu registered, %zu sinks: %s\n", handler->GetRegisteredCount(), CountSinks(actors),
+            registered ? "ok" : "MISMATCH");
+
+        // The fight is over, but before pruning every ex-combatant still reached ProcessEvent
+        for (auto actor : actors) {
+            actor->inCombat = false;
+        }
+        BenchAmbientEvents("Ambient events, sinks left on", actors);
+
+        // Half leave combat, a quarter die and a quarter unload with their cell
+        RE::Mock::ResetEngineCallCounters();
+        start = Clock::now();
+        for (std::size_t i = 0; i < actors.size(); ++i) {
+            if (i % 4 < 2) {
+                SendCombatState(actors[i], RE::ACTOR_COMBAT_STATE::kNone);
+            }
+            else if (i % 4 == 2) {
+                RE::TESDeathEvent event{ actors[i], nullptr, true };
+                handler->ProcessEvent(&event, nullptr);
+            }
+            else {
+                RE::TESCellAttachDetachEvent event{ actors[i], false };
+                handler->ProcessEvent(&event, nullptr);
+            }
+        }
+        PrintResult("Combat end/death/unload (unregisters)", actors.size(), Clock::now() - start, 0);
+        fixture.Frame();
+
+        BenchAmbientEvents("Ambient events, sinks pruned", actors);
+
+        bool slowed = false;
+        for (std::size_t i = 0; i < 8; ++i) {
+            slowed |= slowMgr->IsActorSlowed(actors[i]);
+        }
+        auto dispels = RE::Mock::GetEngineCallCounters().dispelEffect.load();
+        bool pruned = handler->GetRegisteredCount() == 0 && CountSinks(actors) == 0 && !slowed && dispels == 8;
+        std::printf("    %zu registered, %zu sinks, %llu leftover slowdowns dispelled: %s\n",
+            handler->GetRegisteredCount(), CountSinks(actors), static_cast<unsigned long long>(dispels),
+            pruned ? "ok" : "MISMATCH");
+
+        // A game load forgets the old game's combatants; the next combat event registers again
+        for (std::size_t i = 0; i < 16; ++i) {
+            actors[i]->inCombat = true;
+            SendCombatState(actors[i], RE::ACTOR_COMBAT_STATE::kCombat);
+        }
+        handler->Clear();
+        bool forgotten = handler->GetRegisteredCount() == 0;
+        for (std::size_t i = 0; i < 16; ++i) {
+            forgotten &= !handler->IsEligible(actors[i]->GetFormID());
+        }
+        SendCombatState(actors[0], RE::ACTOR_COMBAT_STATE::kCombat);
+        bool reregistered = handler->GetRegisteredCount() == 1 && handler->IsEligible(actors[0]->GetFormID());
+        std::printf("    game load forgets registrations: %s, combat registers again: %s\n", forgotten ? "ok" : "MISMATCH",
+            reregistered ? "ok" : "MISMATCH");
+        for (std::size_t i = 0; i < 16; ++i) {
+            actors[i]->inCombat = false;
+            SendCombatState(actors[i], RE::ACTOR_COMBAT_STATE::kNone);
+            actors[i]->RemoveAnimationGraphEventSink(AnimationEventHandler::GetSingleton());
+        }
+
+        for (auto npc : fixture.npcs) {
+            npc->inCombat = true;
+            SendCombatState(npc, RE::ACTOR_COMBAT_STATE::kCombat);
+        }
+        for (auto& actor : bystanders) {
+            RE::TESForm::UnregisterForm(actor.get());
+        }
+        fixture.Reset();
+        return registered && pruned && forgotten && reregistered;
+    }
+}
@@ -0,0 +1,101 @@
+#include "BenchHarness.h"
+#include "SIGA/Config.h"
+
+#include <thread>
+#include <vector>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t PUBLISH_COUNT = 2000;
+        constexpr std::size_t READER_THREADS = 3;
+
+        // Every field a publish writes carries the same generation, so a reader that sees
+        // two different values has seen a half-updated config
+        Config::Snapshot MakeGeneration(const Config::Snapshot& a_base, std::size_t a_generation) {
+            auto snapshot = a_base;
+            auto multiplier = 0.5f + static_cast<float>(a_generation % 40) * 0.01f;
+            snapshot.bowMultipliers.fill(multiplier);
+            snapshot.castMultipliers.fill(multiplier);
+            snapshot.enableBowDebuff = a_generation % 2 == 0;
+            snapshot.enableCastDebuff = a_generation % 2 == 0;
+            return snapshot;
+        }
+
+        bool IsConsistent(const Config::Snapshot& a_snapshot) {
+            auto multiplier = a_snapshot.bowMultipliers[0];
+            for (auto value : a_snapshot.bowMultipliers) {
+                if (value != multiplier) return false;
+            }
+            for (auto value : a_snapshot.castMultipliers) {
+                if (value != multiplier) return false;
+            }
+            // The compiled table must belong to the same generation as the multipliers
+            return a_snapshot.bowTable.back().magnitude == MagnitudeCurve::MagnitudeFromMultiplier(multiplier) &&
+                   a_snapshot.enableBowDebuff == a_snapshot.enableCastDebuff;
+        }
+    }
+
+    bool RunConfigBenchmarks() {
+        auto config = Config::GetSingleton();
+        auto original = *config->GetSnapshot();
+
+        PrintHeader("Config snapshots");
+
+        // What every animation event pays to read its settings
+        constexpr std::size_t READS = 1 << 24;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < READS; ++i) {
+            auto snapshot = config->GetSnapshot();
+            DoNotOptimize(snapshot->applyToNPCs);
+        }
+        PrintResult("GetSnapshot + field read", READS, Clock::now() - start, 0);
+
+        // Readers checking every snapshot they see while the main thread republishes. The
+        // original's tiers differ, so readers must start on a generation.
+        config->Publish(MakeGeneration(original, 0));
+        std::atomic<bool> publishing = true;
+        std::atomic<std::uint64_t> reads = 0;
+        std::atomic<std::uint64_t> torn = 0;
+        std::vector<std::thread> readers;
+        for (std::size_t t = 0; t < READER_THREADS; ++t) {
+            readers.emplace_back([&]() {
+                std::uint64_t localReads = 0;
+                std::uint64_t localTorn = 0;
+                while (publishing.load(std::memory_order_relaxed)) {
+                    localTorn += !IsConsistent(*config->GetSnapshot());
+                    ++localReads;
+                }
+                reads.fetch_add(localReads);
+                torn.fetch_add(localTorn);
+            });
+        }
+
+        start = Clock::now();
+        for (std::size_t generation = 0; generation < PUBLISH_COUNT; ++generation) {
+            config->Publish(MakeGeneration(original, generation));
+            std::this_thread::yield();
+        }
+        auto elapsed = Clock::now() - start;
+        publishing.store(false);
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        PrintResult("Publish under concurrent readers", PUBLISH_COUNT, elapsed, 0);
+        std::printf("    %llu snapshot reads, %llu inconsistent: %s\n",
+            static_cast<unsigned long long>(reads.load()), static_cast<unsigned long long>(torn.load()),
+            torn.load() == 0 ? "ok" : "MISMATCH");
+
+        // A curve taken from the tiers sees them after clamping
+        auto clamped = Config::Parse("[Bow]\nfNoviceMultiplier = 1.5\nfMasterMultiplier = -0.2\nsCurve = linear\n");
+        bool inRange = clamped && !clamped->bowCurve.points.empty();
+        for (std::size_t i = 0; inRange && i < clamped->bowCurve.points.size(); ++i) {
+            auto multiplier = clamped->bowCurve.points[i].multiplier;
+            inRange = multiplier >= 0.0f && multiplier <= 1.0f;
+        }
+        std::printf("    curve from out-of-range tiers stays within 0-1: %s\n", inRange ? "ok" : "MISMATCH");
+
+        config->Publish(std::move(original));
+        return torn.load() == 0 && inRange;
+    }
+}
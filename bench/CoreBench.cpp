@@ -0,0 +1,207 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/AnimationHandler.h"
+#include "SIGA/SlowMotion.h"
+
+#include <thread>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t STREAM_LENGTH = 1 << 16;
+        constexpr std::size_t STREAM_PASSES = 32;
+        constexpr std::size_t EVENTS_PER_FRAME = 256;
+        constexpr std::size_t SLOWDOWN_ROUNDS = 20000;
+
+        void PrintCoalescing() {
+            auto stats = SlowMotionManager::GetSingleton()->GetCoalescingStats();
+            std::printf("    %llu flushes, %llu casts, %llu dispels, %llu SpeedMult changes, %llu engine calls saved\n",
+                static_cast<unsigned long long>(stats.flushes),
+                static_cast<unsigned long long>(stats.castCalls),
+                static_cast<unsigned long long>(stats.dispelCalls),
+                static_cast<unsigned long long>(stats.modifierCalls),
+                static_cast<unsigned long long>(stats.savedCalls));
+        }
+
+        void BenchProcessEvent(std::string_view a_name, const std::vector<RE::BSAnimationGraphEvent>& a_stream) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto handler = AnimationEventHandler::GetSingleton();
+            auto start = Clock::now();
+            for (std::size_t pass = 0; pass < STREAM_PASSES; ++pass) {
+                for (std::size_t i = 0; i < a_stream.size(); ++i) {
+                    handler->ProcessEvent(&a_stream[i], nullptr);
+                    if ((i + 1) % EVENTS_PER_FRAME == 0) {
+                        fixture.Frame();
+                    }
+                }
+            }
+            auto elapsed = Clock::now() - start;
+
+            PrintResult(a_name, a_stream.size() * STREAM_PASSES, elapsed, EngineCalls());
+            PrintCoalescing();
+        }
+
+        // ApplySlowdown across every actor plus the frame's flush, so each call is a fresh effect
+        void BenchApplySlowdown(std::string_view a_name, SlowType a_type) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            Clock::duration elapsed{};
+            std::uint64_t ops = 0;
+            for (std::size_t round = 0; round < SLOWDOWN_ROUNDS; ++round) {
+                auto start = Clock::now();
+                for (auto npc : fixture.npcs) {
+                    slowMgr->ApplySlowdown(npc, a_type, 50.0f);
+                }
+                fixture.Frame();
+                elapsed += Clock::now() - start;
+                ops += fixture.npcs.size();
+
+                for (auto npc : fixture.npcs) {
+                    slowMgr->RemoveSlowdown(npc, a_type);
+                }
+                fixture.Frame();
+            }
+
+            // Only the timed half counts towards engine calls per op
+            PrintResult(a_name, ops, elapsed, RE::Mock::GetEngineCallCounters().castSpellImmediate.load());
+        }
+
+        // RemoveSlowdown across every actor plus the frame's flush, after an untimed apply
+        void BenchRemoveSlowdown(std::string_view a_name, SlowType a_type) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            Clock::duration elapsed{};
+            std::uint64_t ops = 0;
+            for (std::size_t round = 0; round < SLOWDOWN_ROUNDS; ++round) {
+                for (auto npc : fixture.npcs) {
+                    slowMgr->ApplySlowdown(npc, a_type, 50.0f);
+                }
+                fixture.Frame();
+
+                auto start = Clock::now();
+                for (auto npc : fixture.npcs) {
+                    slowMgr->RemoveSlowdown(npc, a_type);
+                }
+                fixture.Frame();
+                elapsed += Clock::now() - start;
+                ops += fixture.npcs.size();
+            }
+
+            PrintResult(a_name, ops, elapsed, RE::Mock::GetEngineCallCounters().dispelEffect.load());
+        }
+
+        // RemoveSlowdown on actors with no state: what every stray bowRelease/CastStop costs
+        void BenchRemoveSlowdownMiss(std::string_view a_name) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < SLOWDOWN_ROUNDS; ++round) {
+                for (auto npc : fixture.npcs) {
+                    slowMgr->RemoveSlowdown(npc, SlowType::Bow);
+                }
+            }
+            auto elapsed = Clock::now() - start;
+
+            PrintResult(a_name, SLOWDOWN_ROUNDS * fixture.npcs.size(), elapsed, EngineCalls());
+        }
+
+        // A quick shot and a dual cast started and ended inside one frame: the flush
+        // should see no net change and issue nothing
+        void BenchSameFrameChurn(std::string_view a_name) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < SLOWDOWN_ROUNDS; ++round) {
+                for (auto npc : fixture.npcs) {
+                    slowMgr->ApplySlowdown(npc, SlowType::Bow, 50.0f);
+                    slowMgr->RemoveSlowdown(npc, SlowType::Bow);
+                    slowMgr->ApplySlowdown(npc, SlowType::CastLeft, 50.0f);
+                    slowMgr->ApplySlowdown(npc, SlowType::CastRight, 50.0f);
+                    slowMgr->RemoveSlowdown(npc, SlowType::CastLeft);
+                    slowMgr->RemoveSlowdown(npc, SlowType::CastRight);
+                }
+                fixture.Frame();
+            }
+            auto elapsed = Clock::now() - start;
+
+            PrintResult(a_name, SLOWDOWN_ROUNDS * fixture.npcs.size() * 6, elapsed, EngineCalls());
+            PrintCoalescing();
+        }
+
+        // Apply/IsActorSlowed/Remove cycles from several threads, each on its own actors,
+        // the way animation events for a large battle arrive, with the main thread flushing
+        void BenchConcurrentSlowdowns(std::string_view a_name, std::size_t a_threads) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            auto worker = [&](std::size_t a_index) {
+                for (std::size_t round = 0; round < SLOWDOWN_ROUNDS / 4; ++round) {
+                    for (std::size_t i = a_index; i < fixture.npcs.size(); i += a_threads) {
+                        auto npc = fixture.npcs[i];
+                        slowMgr->ApplySlowdown(npc, SlowType::Bow, 50.0f);
+                        DoNotOptimize(slowMgr->IsActorSlowed(npc));
+                        slowMgr->RemoveSlowdown(npc, SlowType::Bow);
+                    }
+                }
+            };
+
+            auto start = Clock::now();
+            std::atomic<std::size_t> running = a_threads;
+            std::vector<std::thread> threads;
+            for (std::size_t t = 0; t < a_threads; ++t) {
+                threads.emplace_back([&, t]() {
+                    worker(t);
+                    running.fetch_sub(1);
+                });
+            }
+            while (running.load() != 0) {
+                fixture.Frame();
+                std::this_thread::yield();
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            fixture.Frame();
+            auto elapsed = Clock::now() - start;
+
+            PrintResult(a_name, (SLOWDOWN_ROUNDS / 4) * fixture.npcs.size() * 3, elapsed, EngineCalls());
+        }
+    }
+
+    bool RunCoreBenchmarks() {
+        auto& fixture = Fixture::Get();
+
+        PrintHeader("ProcessEvent");
+        BenchProcessEvent("ProcessEvent/combat mix", fixture.MakeEventStream(STREAM_LENGTH));
+
+        std::vector<RE::BSAnimationGraphEvent> missOnly;
+        missOnly.reserve(STREAM_LENGTH);
+        for (std::size_t i = 0; i < STREAM_LENGTH; ++i) {
+            missOnly.push_back(RE::BSAnimationGraphEvent{ "FootLeft", fixture.npcs[i % fixture.npcs.size()], {} });
+        }
+        BenchProcessEvent("ProcessEvent/unknown tag only", missOnly);
+
+        PrintHeader("SlowMotionManager");
+        BenchApplySlowdown("ApplySlowdown+flush/bow", SlowType::Bow);
+        BenchApplySlowdown("ApplySlowdown+flush/cast left", SlowType::CastLeft);
+        BenchRemoveSlowdown("RemoveSlowdown+flush/bow", SlowType::Bow);
+        BenchRemoveSlowdown("RemoveSlowdown+flush/cast left", SlowType::CastLeft);
+        BenchRemoveSlowdownMiss("RemoveSlowdown/no state");
+        BenchSameFrameChurn("same-frame shot and dual cast");
+        BenchConcurrentSlowdowns("Apply/IsSlowed/Remove cycle/1 thread", 1);
+        BenchConcurrentSlowdowns("Apply/IsSlowed/Remove cycle/4 threads", 4);
+
+        fixture.Reset();
+        return true;
+    }
+}
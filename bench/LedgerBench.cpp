@@ -0,0 +1,147 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/SlowMotion.h"
+
+#include <functional>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t REPEAT_ROUNDS = 20000;
+
+        struct Sequence {
+            const char* name;
+            std::uint64_t casts;
+            std::uint64_t dispels;
+            std::function<void(RE::Actor*, Fixture&)> run;
+        };
+
+        // Each sequence runs on a clean actor and must leave exactly this many engine calls
+        const Sequence SEQUENCES[] = {
+            { "bow draw, release", 1, 1, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 auto slowMgr = SlowMotionManager::GetSingleton();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::Bow, 50.0f);
+                 a_fixture.Frame();
+                 slowMgr->RemoveSlowdown(a_actor, SlowType::Bow);
+                 a_fixture.Frame();
+             } },
+            { "repeated draw, same tier", 1, 0, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 auto slowMgr = SlowMotionManager::GetSingleton();
+                 for (int i = 0; i < 5; ++i) {
+                     slowMgr->ApplySlowdown(a_actor, SlowType::Bow, 50.0f);
+                     a_fixture.Frame();
+                 }
+             } },
+            // Each tier is its own spell variant, so the old one has to come off
+            { "redraw at another tier", 2, 1, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 auto slowMgr = SlowMotionManager::GetSingleton();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::Bow, 50.0f);
+                 a_fixture.Frame();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::Bow, 90.0f);
+                 a_fixture.Frame();
+             } },
+            { "bow then crossbow", 2, 1, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 auto slowMgr = SlowMotionManager::GetSingleton();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::Bow, 50.0f);
+                 a_fixture.Frame();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::Crossbow, 50.0f);
+                 a_fixture.Frame();
+             } },
+            { "cast, interrupt", 1, 1, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 auto slowMgr = SlowMotionManager::GetSingleton();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::CastLeft, 50.0f);
+                 a_fixture.Frame();
+                 slowMgr->RemoveSlowdown(a_actor, SlowType::CastLeft);
+                 a_fixture.Frame();
+             } },
+            { "dual cast across frames, stop", 2, 2, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 auto slowMgr = SlowMotionManager::GetSingleton();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::CastLeft, 50.0f);
+                 a_fixture.Frame();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::CastRight, 50.0f);
+                 a_fixture.Frame();
+                 slowMgr->RemoveSlowdown(a_actor, SlowType::CastLeft);
+                 slowMgr->RemoveSlowdown(a_actor, SlowType::CastRight);
+                 a_fixture.Frame();
+             } },
+            { "dual cast in one frame, stop", 1, 1, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 auto slowMgr = SlowMotionManager::GetSingleton();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::CastLeft, 50.0f);
+                 slowMgr->ApplySlowdown(a_actor, SlowType::CastRight, 50.0f);
+                 a_fixture.Frame();
+                 slowMgr->RemoveSlowdown(a_actor, SlowType::CastLeft);
+                 slowMgr->RemoveSlowdown(a_actor, SlowType::CastRight);
+                 a_fixture.Frame();
+             } },
+            { "dual cast, release one hand", 2, 1, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 auto slowMgr = SlowMotionManager::GetSingleton();
+                 slowMgr->ApplySlowdown(a_actor, SlowType::CastLeft, 50.0f);
+                 slowMgr->ApplySlowdown(a_actor, SlowType::CastRight, 50.0f);
+                 a_fixture.Frame();
+                 slowMgr->RemoveSlowdown(a_actor, SlowType::CastRight);
+                 a_fixture.Frame();
+             } },
+            { "clear with nothing applied", 0, 0, [](RE::Actor* a_actor, Fixture& a_fixture) {
+                 SlowMotionManager::GetSingleton()->ClearAllSlowdowns(a_actor);
+                 a_fixture.Frame();
+             } },
+        };
+
+        bool RunSequence(const Sequence& a_sequence) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            a_sequence.run(fixture.npcs.front(), fixture);
+
+            auto& counters = RE::Mock::GetEngineCallCounters();
+            auto casts = counters.castSpellImmediate.load();
+            auto dispels = counters.dispelEffect.load();
+            bool match = casts == a_sequence.casts && dispels == a_sequence.dispels;
+            std::printf("%-48s %5llu/%-5llu %5llu/%-5llu %s\n", a_sequence.name,
+                static_cast<unsigned long long>(casts), static_cast<unsigned long long>(a_sequence.casts),
+                static_cast<unsigned long long>(dispels), static_cast<unsigned long long>(a_sequence.dispels),
+                match ? "ok" : "MISMATCH");
+            return match;
+        }
+
+        // A draw event repeated while the slowdown is already applied at that magnitude,
+        // as happens on every BowDrawn re-fire: should cost no flush and no engine call
+        void BenchRepeatedApply(std::string_view a_name) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            for (auto npc : fixture.npcs) {
+                slowMgr->ApplySlowdown(npc, SlowType::Bow, 50.0f);
+            }
+            fixture.Frame();
+            RE::Mock::ResetEngineCallCounters();
+
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < REPEAT_ROUNDS; ++round) {
+                for (auto npc : fixture.npcs) {
+                    slowMgr->ApplySlowdown(npc, SlowType::Bow, 50.0f);
+                }
+                fixture.Frame();
+            }
+            auto elapsed = Clock::now() - start;
+
+            PrintResult(a_name, REPEAT_ROUNDS * fixture.npcs.size(), elapsed, EngineCalls());
+        }
+    }
+
+    bool RunLedgerBenchmarks() {
+        std::printf("\n== Effect ledger\n");
+        std::printf("%-48s %11s %11s\n", "sequence", "casts", "dispels");
+
+        bool passed = true;
+        for (auto& sequence : SEQUENCES) {
+            passed &= RunSequence(sequence);
+        }
+
+        PrintHeader("Effect ledger timing");
+        BenchRepeatedApply("ApplySlowdown+flush/already applied");
+
+        Fixture::Get().Reset();
+        return passed;
+    }
+}
@@ -0,0 +1,198 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/CombatEventHandler.h"
+#include "SIGA/Metrics.h"
+#include "SIGA/SlowMotion.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t LOCK_ROUNDS = 1 << 22;
+        constexpr std::size_t CONTENDED_ROUNDS = 1 << 18;
+        constexpr std::size_t SLOWDOWN_ROUNDS = 1 << 14;
+        constexpr std::size_t WORKER_THREADS = 4;
+
+        template <class Body>
+        void RunThreads(Body&& a_body) {
+            std::vector<std::thread> threads;
+            for (std::size_t t = 0; t < WORKER_THREADS; ++t) {
+                threads.emplace_back([&a_body, t]() { a_body(t); });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        std::uint64_t Sum(const std::array<std::uint64_t, Metrics::HISTOGRAM_BUCKETS>& a_buckets) {
+            std::uint64_t total = 0;
+            for (auto count : a_buckets) {
+                total += count;
+            }
+            return total;
+        }
+
+        void SendCombatState(RE::Actor* a_actor, RE::ACTOR_COMBAT_STATE a_state) {
+            RE::TESCombatEvent event{ a_actor, nullptr, a_state };
+            CombatEventHandler::GetSingleton()->ProcessEvent(&event, nullptr);
+        }
+
+        // Every acquire records one wait and one hold, contended or not
+        bool CheckContendedCounts() {
+            auto metrics = Metrics::GetSingleton();
+            metrics->Reset();
+
+            std::mutex mutex;
+            std::uint64_t shared = 0;
+            auto start = Clock::now();
+            RunThreads([&](std::size_t) {
+                for (std::size_t i = 0; i < CONTENDED_ROUNDS; ++i) {
+                    Metrics::TimedLock lock(mutex, Metrics::Lock::kTimerWheel);
+                    ++shared;
+                }
+            });
+            PrintResult("TimedLock, 4 threads on one mutex", WORKER_THREADS * CONTENDED_ROUNDS, Clock::now() - start, 0);
+
+            auto stats = metrics->Collect();
+            auto& waits = stats.lockWaits[static_cast<std::size_t>(Metrics::Lock::kTimerWheel)];
+            auto acquired = Sum(waits);
+            auto held = Sum(stats.lockHolds[static_cast<std::size_t>(Metrics::Lock::kTimerWheel)]);
+            bool ok = shared == WORKER_THREADS * CONTENDED_ROUNDS && acquired == shared && held == shared;
+            std::printf("    %llu acquires, %llu contended, %llu holds: %s\n", static_cast<unsigned long long>(acquired),
+                static_cast<unsigned long long>(acquired - waits[0]), static_cast<unsigned long long>(held), ok ? "ok" : "MISMATCH");
+            return ok;
+        }
+
+        // Threads slowing different actors queue them on separate pending shards while the
+        // main thread flushes; every slowdown still comes off
+        bool CheckShardedPending() {
+            auto& fixture = Fixture::Get();
+            auto metrics = Metrics::GetSingleton();
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            fixture.Reset();
+            metrics->Reset();
+
+            std::atomic<std::size_t> running = WORKER_THREADS;
+            std::thread flusher([&]() {
+                while (running.load(std::memory_order_acquire) != 0) {
+                    fixture.Frame();
+                }
+            });
+            auto start = Clock::now();
+            RunThreads([&](std::size_t a_thread) {
+                for (std::size_t round = 0; round < SLOWDOWN_ROUNDS; ++round) {
+                    for (std::size_t i = a_thread; i < fixture.npcs.size(); i += WORKER_THREADS) {
+                        slowMgr->ApplySlowdown(fixture.npcs[i], SlowType::Bow, 50.0f);
+                        slowMgr->RemoveSlowdown(fixture.npcs[i], SlowType::Bow);
+                    }
+                }
+                running.fetch_sub(1, std::memory_order_acq_rel);
+            });
+            flusher.join();
+            auto elapsed = Clock::now() - start;
+            fixture.Frame();
+            PrintResult("apply+remove, 4 threads, flushing", SLOWDOWN_ROUNDS * fixture.npcs.size(), elapsed, EngineCalls());
+
+            bool clean = true;
+            for (auto npc : fixture.npcs) {
+                clean &= !slowMgr->IsActorSlowed(npc) && npc->GetMagicTarget()->activeEffects.empty();
+            }
+            auto stats = metrics->Collect();
+            auto& waits = stats.lockWaits[static_cast<std::size_t>(Metrics::Lock::kPendingActors)];
+            bool recorded = Sum(waits) > 0;
+            std::printf("    %llu pending-shard acquires, %llu contended, every NPC released: %s\n",
+                static_cast<unsigned long long>(Sum(waits)), static_cast<unsigned long long>(Sum(waits) - waits[0]),
+                clean && recorded ? "ok" : "MISMATCH");
+            return clean && recorded;
+        }
+
+        // Threads delivering the same combat start add each sink once; the claim stops
+        // the rest before they reach the engine
+        bool CheckConcurrentRegistration() {
+            auto& fixture = Fixture::Get();
+            auto handler = CombatEventHandler::GetSingleton();
+            auto metrics = Metrics::GetSingleton();
+            metrics->Reset();
+
+            for (auto npc : fixture.npcs) {
+                SendCombatState(npc, RE::ACTOR_COMBAT_STATE::kNone);
+                npc->inCombat = true;
+            }
+            RunThreads([&](std::size_t) {
+                for (auto npc : fixture.npcs) {
+                    SendCombatState(npc, RE::ACTOR_COMBAT_STATE::kCombat);
+                }
+            });
+
+            std::size_t sinks = 0;
+            bool eligible = true;
+            for (auto npc : fixture.npcs) {
+                sinks += npc->animationGraphEventSource.GetSinkCount();
+                eligible &= handler->IsEligible(npc->GetFormID());
+            }
+            auto stats = metrics->Collect();
+            auto acquired = Sum(stats.lockWaits[static_cast<std::size_t>(Metrics::Lock::kRegistration)]);
+            bool ok = handler->GetRegisteredCount() == fixture.npcs.size() && sinks == fixture.npcs.size() && eligible && acquired > 0;
+            std::printf("    %zu NPCs, %zu registered, %zu sinks, all eligible: %s\n", fixture.npcs.size(),
+                handler->GetRegisteredCount(), sinks, ok ? "ok" : "MISMATCH");
+            return ok;
+        }
+    }
+
+    bool RunLockBenchmarks() {
+        auto& fixture = Fixture::Get();
+        auto metrics = Metrics::GetSingleton();
+
+        auto directory = std::filesystem::temp_directory_path() / "siga_lock_bench";
+        std::filesystem::create_directories(directory);
+        auto path = directory / "SigaNG.stats";
+        metrics->SetOutput(path);
+
+        PrintHeader("Locks");
+        bool passed = true;
+
+        // What instrumenting an uncontended lock costs, off and on
+        std::mutex mutex;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < LOCK_ROUNDS; ++i) {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+        PrintResult("lock_guard, uncontended", LOCK_ROUNDS, Clock::now() - start, 0);
+
+        start = Clock::now();
+        for (std::size_t i = 0; i < LOCK_ROUNDS; ++i) {
+            Metrics::TimedLock lock(mutex, Metrics::Lock::kTimerWheel);
+        }
+        PrintResult("TimedLock, metrics off", LOCK_ROUNDS, Clock::now() - start, 0);
+
+        metrics->Reset();
+        metrics->SetEnabled(true);
+        start = Clock::now();
+        for (std::size_t i = 0; i < LOCK_ROUNDS; ++i) {
+            Metrics::TimedLock lock(mutex, Metrics::Lock::kTimerWheel);
+        }
+        PrintResult("TimedLock, metrics on", LOCK_ROUNDS, Clock::now() - start, 0);
+
+        passed &= CheckContendedCounts();
+        passed &= CheckShardedPending();
+        passed &= CheckConcurrentRegistration();
+
+        metrics->SetEnabled(false);
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        auto text = contents.str();
+        bool dumped = text.find("[Locks, ns]") != std::string::npos && text.find("Registration") != std::string::npos &&
+                      text.find("PendingActors") != std::string::npos && text.find("TimerWheel") != std::string::npos;
+        std::printf("    lock wait and hold in the stats file: %s\n", dumped ? "ok" : "MISMATCH");
+        passed &= dumped;
+
+        metrics->Reset();
+        metrics->SetOutput({});
+        fixture.Reset();
+        std::filesystem::remove_all(directory);
+        return passed;
+    }
+}
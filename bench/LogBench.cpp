@@ -0,0 +1,124 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/AnimationHandler.h"
+#include "SIGA/Log.h"
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t CALL_ROUNDS = 1 << 16;
+        constexpr std::size_t STREAM_LENGTH = 1 << 16;
+        constexpr std::size_t EVENTS_PER_FRAME = 256;
+
+        // What a debug call with an argument to compute costs when debug is off
+        void BenchDisabledDebugCall() {
+            auto& fixture = Fixture::Get();
+            std::size_t calls = 0;
+
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < CALL_ROUNDS; ++round) {
+                for (auto npc : fixture.npcs) {
+                    logger::debug("Queued slowdown for {}", npc->GetName());
+                    DoNotOptimize(++calls);
+                }
+            }
+            PrintResult("debug off/logger::debug", calls, Clock::now() - start, 0);
+
+            calls = 0;
+            start = Clock::now();
+            for (std::size_t round = 0; round < CALL_ROUNDS; ++round) {
+                for (auto npc : fixture.npcs) {
+                    SIGA_LOG_DEBUG("Queued slowdown for {}", npc->GetName());
+                    DoNotOptimize(++calls);
+                }
+            }
+            PrintResult("debug off/SIGA_LOG_DEBUG", calls, Clock::now() - start, 0);
+
+            start = Clock::now();
+            calls = RunStrippedDebugCalls(fixture.npcs, CALL_ROUNDS);
+            PrintResult("debug off/SIGA_LOG_DEBUG stripped", calls, Clock::now() - start, 0);
+        }
+
+        // What the calling thread pays per message that is written
+        void BenchMessages(std::string_view a_name, spdlog::logger& a_log) {
+            auto& fixture = Fixture::Get();
+            std::size_t calls = 0;
+
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < STREAM_LENGTH; ++i) {
+                auto npc = fixture.npcs[i % fixture.npcs.size()];
+                a_log.info("Queued slowdown for {} (magnitude: {})", npc->GetName(), 50.0f);
+                DoNotOptimize(++calls);
+            }
+            auto elapsed = Clock::now() - start;
+
+            // Not timed: an async logger's writes are its own thread's cost
+            a_log.flush();
+            PrintResult(a_name, calls, elapsed, 0);
+        }
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+        // The event stream with a_log as the default logger, so every trace and debug call
+        // in ProcessEvent and SlowMotionManager is written
+        void BenchLoggedStream(std::string_view a_name, const std::vector<RE::BSAnimationGraphEvent>& a_stream,
+            std::shared_ptr<spdlog::logger> a_log) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto previous = spdlog::default_logger();
+            spdlog::set_default_logger(a_log);
+
+            auto handler = AnimationEventHandler::GetSingleton();
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < a_stream.size(); ++i) {
+                handler->ProcessEvent(&a_stream[i], nullptr);
+                if ((i + 1) % EVENTS_PER_FRAME == 0) {
+                    fixture.Frame();
+                }
+            }
+            auto elapsed = Clock::now() - start;
+
+            // Not timed: an async logger's writes are its own thread's cost
+            a_log->flush();
+            spdlog::set_default_logger(std::move(previous));
+            PrintResult(a_name, a_stream.size(), elapsed, EngineCalls());
+        }
+#endif
+    }
+
+    bool RunLogBenchmarks() {
+        auto& fixture = Fixture::Get();
+
+        auto directory = std::filesystem::temp_directory_path() / "siga_log_bench";
+        std::filesystem::create_directories(directory);
+
+        PrintHeader("Logging");
+        BenchDisabledDebugCall();
+
+        // The plugin's old setup, flushing every info line, against the async logger
+        auto syncLog = std::make_shared<spdlog::logger>("bench sync log",
+            std::make_shared<spdlog::sinks::basic_file_sink_mt>((directory / "sync.log").string(), true));
+        syncLog->set_level(spdlog::level::trace);
+        syncLog->flush_on(spdlog::level::info);
+        BenchMessages("info message/sync file, flush on info", *syncLog);
+
+        auto asyncLog = Log::MakeAsyncLogger("bench async log",
+            std::make_shared<spdlog::sinks::basic_file_sink_mt>((directory / "async.log").string(), true));
+        asyncLog->set_level(spdlog::level::trace);
+        asyncLog->flush_on(spdlog::level::warn);
+        BenchMessages("info message/async file", *asyncLog);
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+        auto stream = fixture.MakeEventStream(STREAM_LENGTH);
+        BenchLoggedStream("ProcessEvent/trace off", stream, spdlog::default_logger());
+        BenchLoggedStream("ProcessEvent/trace on, sync file", stream, syncLog);
+        BenchLoggedStream("ProcessEvent/trace on, async file", stream, asyncLog);
+#else
+        std::printf("    trace and debug are compiled out of this build; configure with\n"
+                    "    -DSIGA_STRIP_DEBUG_LOGS=OFF to time ProcessEvent with them on\n");
+#endif
+
+        fixture.Reset();
+        std::filesystem::remove_all(directory);
+        return true;
+    }
+}
@@ -0,0 +1,20 @@
+#include "BenchHarness.h"
+
+// Built as a Release build with SIGA_STRIP_DEBUG_LOGS would build it, whatever this build's
+// type, so LogBench can compare a stripped debug call against the runtime-checked one
+#undef SPDLOG_ACTIVE_LEVEL
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#include "SIGA/Log.h"
+
+namespace SIGA::Bench {
+    std::size_t RunStrippedDebugCalls(const std::vector<RE::Actor*>& a_actors, std::size_t a_rounds) {
+        std::size_t calls = 0;
+        for (std::size_t round = 0; round < a_rounds; ++round) {
+            for (auto actor : a_actors) {
+                SIGA_LOG_DEBUG("Queued slowdown for {}", actor->GetName());
+                DoNotOptimize(++calls);
+            }
+        }
+        return calls;
+    }
+}
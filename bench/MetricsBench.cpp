@@ -0,0 +1,148 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/AnimationHandler.h"
+#include "SIGA/Metrics.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t COUNT_CALLS = 1 << 24;
+        constexpr std::size_t STREAM_LENGTH = 1 << 16;
+        constexpr std::size_t STREAM_PASSES = 8;
+        constexpr std::size_t EVENTS_PER_FRAME = 256;
+        constexpr std::size_t COUNTING_THREADS = 4;
+
+        void BenchProcessEvent(std::string_view a_name, const std::vector<RE::BSAnimationGraphEvent>& a_stream) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto handler = AnimationEventHandler::GetSingleton();
+            auto start = Clock::now();
+            for (std::size_t pass = 0; pass < STREAM_PASSES; ++pass) {
+                for (std::size_t i = 0; i < a_stream.size(); ++i) {
+                    handler->ProcessEvent(&a_stream[i], nullptr);
+                    if ((i + 1) % EVENTS_PER_FRAME == 0) {
+                        fixture.Frame();
+                    }
+                }
+            }
+            fixture.Frame();
+            PrintResult(a_name, a_stream.size() * STREAM_PASSES, Clock::now() - start, EngineCalls());
+        }
+
+        void BenchCount(std::string_view a_name) {
+            auto metrics = Metrics::GetSingleton();
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < COUNT_CALLS; ++i) {
+                metrics->Count(Metrics::Counter::kCastSpell);
+            }
+            PrintResult(a_name, COUNT_CALLS, Clock::now() - start, 0);
+        }
+
+        // Every event has a holder, so each is classified once before any other stage
+        // rejects it, and every cast and dispel the engine saw was counted
+        bool CheckStreamTotals(std::uint64_t a_events) {
+            auto stats = Metrics::GetSingleton()->Collect();
+            auto counter = [&](Metrics::Counter a_counter) { return stats.counters[static_cast<std::size_t>(a_counter)]; };
+
+            std::uint64_t classified = 0;
+            for (auto count : stats.events) {
+                classified += count;
+            }
+            auto rejected = counter(Metrics::Counter::kRejectNoActor) + counter(Metrics::Counter::kRejectUnknownTag) +
+                            counter(Metrics::Counter::kRejectNotEligible) + counter(Metrics::Counter::kRejectQueueFull) +
+                            counter(Metrics::Counter::kRejectNPCsDisabled) +
+                            counter(Metrics::Counter::kRejectNotInCombat);
+
+            auto& engine = RE::Mock::GetEngineCallCounters();
+            std::uint64_t applies = 0;
+            for (auto bucket : stats.histograms[static_cast<std::size_t>(Metrics::Histogram::kApplySlowdown)]) {
+                applies += bucket;
+            }
+
+            bool ok = counter(Metrics::Counter::kProcessEvent) == a_events && classified == a_events && rejected <= a_events &&
+                      counter(Metrics::Counter::kRejectUnknownTag) == stats.events[0] &&
+                      counter(Metrics::Counter::kCastSpell) == engine.castSpellImmediate.load() &&
+                      counter(Metrics::Counter::kDispelSpell) == engine.dispelEffect.load() && applies > 0;
+            std::printf("    %llu events, %llu classified, %llu unknown, %llu casts, %llu ApplySlowdown timed: %s\n",
+                static_cast<unsigned long long>(counter(Metrics::Counter::kProcessEvent)),
+                static_cast<unsigned long long>(classified), static_cast<unsigned long long>(stats.events[0]),
+                static_cast<unsigned long long>(counter(Metrics::Counter::kCastSpell)),
+                static_cast<unsigned long long>(applies), ok ? "ok" : "MISMATCH");
+            std::printf("    rejected by stage: no actor %llu, unknown tag %llu, not eligible %llu, NPCs off %llu, not in combat %llu\n",
+                static_cast<unsigned long long>(counter(Metrics::Counter::kRejectNoActor)),
+                static_cast<unsigned long long>(counter(Metrics::Counter::kRejectUnknownTag)),
+                static_cast<unsigned long long>(counter(Metrics::Counter::kRejectNotEligible)),
+                static_cast<unsigned long long>(counter(Metrics::Counter::kRejectNPCsDisabled)),
+                static_cast<unsigned long long>(counter(Metrics::Counter::kRejectNotInCombat)));
+            return ok;
+        }
+
+        // Per-thread blocks lose nothing, however many threads count at once
+        bool CheckThreadedCounts() {
+            auto metrics = Metrics::GetSingleton();
+            metrics->Reset();
+
+            std::vector<std::thread> threads;
+            for (std::size_t t = 0; t < COUNTING_THREADS; ++t) {
+                threads.emplace_back([metrics]() {
+                    for (std::size_t i = 0; i < COUNT_CALLS / 16; ++i) {
+                        metrics->Count(Metrics::Counter::kDispelSpell);
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            auto total = metrics->Collect().counters[static_cast<std::size_t>(Metrics::Counter::kDispelSpell)];
+            bool ok = total == COUNTING_THREADS * (COUNT_CALLS / 16);
+            std::printf("    %zu threads counted %llu: %s\n", COUNTING_THREADS, static_cast<unsigned long long>(total), ok ? "ok" : "MISMATCH");
+            return ok;
+        }
+    }
+
+    bool RunMetricsBenchmarks() {
+        auto& fixture = Fixture::Get();
+        auto metrics = Metrics::GetSingleton();
+        auto stream = fixture.MakeEventStream(STREAM_LENGTH);
+
+        auto directory = std::filesystem::temp_directory_path() / "siga_metrics_bench";
+        std::filesystem::create_directories(directory);
+        auto path = directory / "SigaNG.stats";
+        metrics->SetOutput(path);
+
+        PrintHeader("Metrics");
+        bool passed = true;
+
+        BenchCount("Count/disabled");
+        BenchProcessEvent("ProcessEvent/metrics off", stream);
+
+        metrics->Reset();
+        metrics->SetEnabled(true);
+        BenchCount("Count/enabled");
+        // Dispels left over from the previous run happen before the count starts
+        fixture.Reset();
+        metrics->Reset();
+        BenchProcessEvent("ProcessEvent/metrics on", stream);
+        passed &= CheckStreamTotals(stream.size() * STREAM_PASSES);
+        passed &= CheckThreadedCounts();
+
+        metrics->SetEnabled(false);
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        bool dumped = contents.str().find("[Latency, ns]") != std::string::npos;
+        std::printf("    stats file written on disable: %s\n", dumped ? "ok" : "MISMATCH");
+        passed &= dumped;
+
+        metrics->Reset();
+        metrics->SetOutput({});
+        fixture.Reset();
+        std::filesystem::remove_all(directory);
+        return passed;
+    }
+}
@@ -0,0 +1,75 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/AnimationHandler.h"
+#include "SIGA/PlayerGraphHandler.h"
+#include "SIGA/SlowMotion.h"
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t REBUILD_ROUNDS = 100000;
+
+        std::size_t PlayerSinks() {
+            return Fixture::Get().player->animationGraphEventSource.GetSinkCount();
+        }
+
+        // The engine drops a graph's sinks along with the graph
+        void DropPlayerGraph() {
+            Fixture::Get().player->RemoveAnimationGraphEventSink(AnimationEventHandler::GetSingleton());
+        }
+    }
+
+    bool RunPlayerBenchmarks() {
+        auto& fixture = Fixture::Get();
+        fixture.Reset();
+
+        auto handler = PlayerGraphHandler::GetSingleton();
+        auto slowMgr = SlowMotionManager::GetSingleton();
+        auto player = fixture.player;
+
+        PrintHeader("Player sink");
+
+        // Game loaded before the player's 3D: registration waits for the load event
+        DropPlayerGraph();
+        player->hasAnimationGraph = false;
+        bool early = handler->Register();
+        player->hasAnimationGraph = true;
+        RE::TESObjectLoadedEvent loaded{ player->GetFormID(), true };
+        handler->ProcessEvent(&loaded, nullptr);
+        bool attachedOnLoad = !early && PlayerSinks() == 1;
+        std::printf("    register before 3D: %s, after 3D load: %zu sink: %s\n", early ? "attached" : "deferred",
+            PlayerSinks(), attachedOnLoad ? "ok" : "MISMATCH");
+
+        // Transform mid-draw: the new graph gets the sink and the orphaned slowdown goes
+        slowMgr->ApplySlowdown(player, SlowType::Bow, 50.0f);
+        fixture.Frame();
+        DropPlayerGraph();
+        RE::TESSwitchRaceCompleteEvent raceSwitch{ player };
+        handler->ProcessEvent(&raceSwitch, nullptr);
+        fixture.Frame();
+        bool attachedOnSwitch = PlayerSinks() == 1 && !slowMgr->IsActorSlowed(player);
+        std::printf("    after race switch: %zu sink, %s: %s\n", PlayerSinks(),
+            slowMgr->IsActorSlowed(player) ? "still slowed" : "slowdown cleared", attachedOnSwitch ? "ok" : "MISMATCH");
+
+        // Other actors' events leave the player alone, and re-registering never doubles up
+        auto npc = fixture.npcs.front();
+        auto npcSinks = npc->animationGraphEventSource.GetSinkCount();
+        RE::TESObjectLoadedEvent npcLoaded{ npc->GetFormID(), true };
+        RE::TESSwitchRaceCompleteEvent npcSwitch{ npc };
+        handler->ProcessEvent(&npcLoaded, nullptr);
+        handler->ProcessEvent(&npcSwitch, nullptr);
+        handler->Register();
+        bool isolated = PlayerSinks() == 1 && npc->animationGraphEventSource.GetSinkCount() == npcSinks;
+        std::printf("    after NPC events and a second Register: %zu sink: %s\n", PlayerSinks(), isolated ? "ok" : "MISMATCH");
+
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < REBUILD_ROUNDS; ++i) {
+            DropPlayerGraph();
+            handler->ProcessEvent(&raceSwitch, nullptr);
+        }
+        PrintResult("Graph rebuild + re-attach", REBUILD_ROUNDS, Clock::now() - start, 0);
+
+        DropPlayerGraph();
+        fixture.Reset();
+        return attachedOnLoad && attachedOnSwitch && isolated;
+    }
+}
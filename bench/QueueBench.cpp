@@ -0,0 +1,248 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/AnimationHandler.h"
+#include "SIGA/CombatEventHandler.h"
+#include "SIGA/Metrics.h"
+#include "SIGA/MpscQueue.h"
+#include "SIGA/SlowMotion.h"
+
+#include <thread>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::uint32_t RING_CAPACITY = 4096;
+        constexpr std::size_t RING_ROUNDS = 1 << 10;
+        constexpr std::size_t PRODUCER_THREADS = 4;
+        constexpr std::size_t PRODUCER_PUSHES = 1 << 20;
+        constexpr std::size_t STREAM_LENGTH = 1 << 16;
+        constexpr std::size_t STREAM_PASSES = 8;
+        constexpr std::size_t EVENTS_PER_FRAME = 256;
+        constexpr std::size_t OVERFLOW_EVENTS = 16;
+
+        constexpr RE::FormID TEMPORARY_FORMID = 0xFF000B00;
+
+        using Ring = MpscQueue<std::uint64_t, RING_CAPACITY>;
+
+        void SendCombatState(RE::Actor* a_actor, RE::ACTOR_COMBAT_STATE a_state) {
+            RE::TESCombatEvent event{ a_actor, nullptr, a_state };
+            CombatEventHandler::GetSingleton()->ProcessEvent(&event, nullptr);
+        }
+
+        std::uint64_t Counted(Metrics::Counter a_counter) {
+            return Metrics::GetSingleton()->Collect().counters[static_cast<std::size_t>(a_counter)];
+        }
+
+        // Producers racing the consumer lose nothing, duplicate nothing, and each one's
+        // entries come out in the order it pushed them
+        bool CheckProducers() {
+            auto ring = std::make_unique<Ring>();
+            std::atomic<std::size_t> running = PRODUCER_THREADS;
+            std::atomic<std::uint64_t> refused = 0;
+
+            std::vector<std::thread> producers;
+            auto start = Clock::now();
+            for (std::uint64_t p = 0; p < PRODUCER_THREADS; ++p) {
+                producers.emplace_back([&, p]() {
+                    std::uint64_t full = 0;
+                    for (std::uint64_t i = 0; i < PRODUCER_PUSHES; ++i) {
+                        while (!ring->TryPush(p << 32 | i)) {
+                            // Give the consumer the core rather than spin against it
+                            ++full;
+                            std::this_thread::yield();
+                        }
+                    }
+                    refused.fetch_add(full, std::memory_order_relaxed);
+                    running.fetch_sub(1, std::memory_order_acq_rel);
+                });
+            }
+
+            std::array<std::uint64_t, PRODUCER_THREADS> next{};
+            std::size_t received = 0;
+            bool ordered = true;
+            auto consume = [&](std::uint64_t a_value) {
+                auto producer = a_value >> 32;
+                ordered &= producer < PRODUCER_THREADS && (a_value & 0xFFFFFFFF) == next[producer];
+                if (producer < PRODUCER_THREADS) {
+                    ++next[producer];
+                }
+                ++received;
+            };
+            while (running.load(std::memory_order_acquire) != 0) {
+                if (ring->Drain(consume) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            for (auto& producer : producers) {
+                producer.join();
+            }
+            ring->Drain(consume);
+            PrintResult("4 producers, 1 consumer (per entry)", PRODUCER_THREADS * PRODUCER_PUSHES, Clock::now() - start, 0);
+
+            bool ok = ordered && received == PRODUCER_THREADS * PRODUCER_PUSHES;
+            std::printf("    %zu received in producer order, %llu pushes refused while full: %s\n", received,
+                static_cast<unsigned long long>(refused.load()), ok ? "ok" : "MISMATCH");
+            return ok;
+        }
+
+        // What the animation thread now pays per event, and what the main thread pays later
+        void BenchSplit(const std::vector<RE::BSAnimationGraphEvent>& a_stream) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+
+            auto handler = AnimationEventHandler::GetSingleton();
+            Clock::duration animation{};
+            Clock::duration main{};
+            for (std::size_t pass = 0; pass < STREAM_PASSES; ++pass) {
+                for (std::size_t i = 0; i < a_stream.size(); i += EVENTS_PER_FRAME) {
+                    auto start = Clock::now();
+                    for (std::size_t j = i; j < i + EVENTS_PER_FRAME && j < a_stream.size(); ++j) {
+                        handler->ProcessEvent(&a_stream[j], nullptr);
+                    }
+                    auto queued = Clock::now();
+                    fixture.Frame();
+                    animation += queued - start;
+                    main += Clock::now() - queued;
+                }
+            }
+            PrintResult("ProcessEvent, animation thread", a_stream.size() * STREAM_PASSES, animation, 0);
+            PrintResult("drain + flush, main thread", a_stream.size() * STREAM_PASSES, main, EngineCalls());
+        }
+
+        // A full queue drops the overflow and counts it; what got in is still handled
+        bool CheckOverflow() {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+            auto handler = AnimationEventHandler::GetSingleton();
+            auto npc = fixture.npcs[1];
+
+            RE::BSAnimationGraphEvent drawn{ "BowDrawn", npc, {} };
+            for (std::size_t i = 0; i < RING_CAPACITY + OVERFLOW_EVENTS; ++i) {
+                handler->ProcessEvent(&drawn, nullptr);
+            }
+            auto dropped = Counted(Metrics::Counter::kRejectQueueFull);
+            fixture.Frame();
+
+            bool ok = dropped == OVERFLOW_EVENTS && SlowMotionManager::GetSingleton()->IsActorSlowed(npc) &&
+                      npc->GetMagicTarget()->activeEffects.size() == 1;
+            std::printf("    %llu of %zu dropped at a full queue, the rest applied once: %s\n",
+                static_cast<unsigned long long>(dropped), OVERFLOW_EVENTS, ok ? "ok" : "MISMATCH");
+            fixture.Reset();
+            return ok;
+        }
+
+        // Animation threads pushing while the main thread drains: whatever a push finds, the
+        // last event each thread sends is handled by the next frame, not left waiting for an
+        // unrelated event to schedule a drain
+        bool CheckNoStrandedEvents() {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+            auto handler = AnimationEventHandler::GetSingleton();
+
+            // Under the queue's capacity even if no drain ran, so nothing is dropped
+            constexpr std::size_t PAIRS = RING_CAPACITY / PRODUCER_THREADS / 2 - 1;
+            std::atomic<std::size_t> running = PRODUCER_THREADS;
+            std::vector<std::thread> producers;
+            for (std::size_t p = 0; p < PRODUCER_THREADS; ++p) {
+                producers.emplace_back([&, npc = fixture.npcs[p + 1]]() {
+                    RE::BSAnimationGraphEvent drawn{ "BowDrawn", npc, {} };
+                    RE::BSAnimationGraphEvent release{ "BowRelease", npc, {} };
+                    for (std::size_t i = 0; i < PAIRS; ++i) {
+                        handler->ProcessEvent(&drawn, nullptr);
+                        handler->ProcessEvent(&release, nullptr);
+                    }
+                    handler->ProcessEvent(&drawn, nullptr);
+                    running.fetch_sub(1, std::memory_order_acq_rel);
+                });
+            }
+            while (running.load(std::memory_order_acquire) != 0) {
+                fixture.Frame();
+            }
+            for (auto& producer : producers) {
+                producer.join();
+            }
+            fixture.Frame();
+
+            bool ok = true;
+            for (std::size_t p = 0; p < PRODUCER_THREADS; ++p) {
+                auto npc = fixture.npcs[p + 1];
+                ok &= SlowMotionManager::GetSingleton()->IsActorSlowed(npc) && npc->GetMagicTarget()->activeEffects.size() == 1;
+            }
+            std::printf("    %zu animation threads racing the drain, every last draw handled next frame: %s\n", PRODUCER_THREADS,
+                ok ? "ok" : "MISMATCH");
+            fixture.Reset();
+            return ok;
+        }
+
+        // An actor deleted while its event waits is skipped, and a load discards the queue
+        bool CheckStaleEvents() {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+            auto handler = AnimationEventHandler::GetSingleton();
+            auto slowMgr = SlowMotionManager::GetSingleton();
+
+            auto temporary = std::make_unique<RE::Actor>();
+            temporary->formID = TEMPORARY_FORMID;
+            temporary->fullName = "Conjured Archer";
+            temporary->inCombat = true;
+            temporary->equippedRight = fixture.bow;
+            RE::TESForm::RegisterForm(temporary.get());
+            SendCombatState(temporary.get(), RE::ACTOR_COMBAT_STATE::kCombat);
+
+            auto noActor = Counted(Metrics::Counter::kRejectNoActor);
+            RE::BSAnimationGraphEvent drawn{ "BowDrawn", temporary.get(), {} };
+            handler->ProcessEvent(&drawn, nullptr);
+            SendCombatState(temporary.get(), RE::ACTOR_COMBAT_STATE::kNone);
+            RE::Mock::ReleaseHandle(temporary.get());
+            RE::TESForm::UnregisterForm(temporary.get());
+            fixture.Frame();
+            bool skipped = Counted(Metrics::Counter::kRejectNoActor) == noActor + 1 && temporary->GetMagicTarget()->activeEffects.empty();
+
+            auto npc = fixture.npcs[1];
+            RE::BSAnimationGraphEvent npcDrawn{ "BowDrawn", npc, {} };
+            handler->ProcessEvent(&npcDrawn, nullptr);
+            handler->DiscardQueued();
+            fixture.Frame();
+            bool discarded = !slowMgr->IsActorSlowed(npc) && npc->GetMagicTarget()->activeEffects.empty();
+
+            std::printf("    deleted actor's event skipped: %s, queue discarded on load: %s\n", skipped ? "ok" : "MISMATCH",
+                discarded ? "ok" : "MISMATCH");
+            fixture.Reset();
+            return skipped && discarded;
+        }
+    }
+
+    bool RunQueueBenchmarks() {
+        auto& fixture = Fixture::Get();
+        auto metrics = Metrics::GetSingleton();
+        auto stream = fixture.MakeEventStream(STREAM_LENGTH);
+
+        PrintHeader("Event queue");
+        bool passed = true;
+
+        auto ring = std::make_unique<Ring>();
+        std::uint64_t total = 0;
+        auto start = Clock::now();
+        for (std::size_t round = 0; round < RING_ROUNDS; ++round) {
+            for (std::uint64_t i = 0; i < RING_CAPACITY; ++i) {
+                ring->TryPush(i);
+            }
+            ring->Drain([&total](std::uint64_t a_value) { total += a_value; });
+        }
+        DoNotOptimize(total);
+        PrintResult("push + drain, 1 thread", RING_ROUNDS * RING_CAPACITY, Clock::now() - start, 0);
+
+        passed &= CheckProducers();
+        BenchSplit(stream);
+
+        metrics->Reset();
+        metrics->SetEnabled(true);
+        passed &= CheckOverflow();
+        passed &= CheckStaleEvents();
+        passed &= CheckNoStrandedEvents();
+        metrics->SetEnabled(false);
+        metrics->Reset();
+
+        fixture.Reset();
+        return passed;
+    }
+}
@@ -0,0 +1,135 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/ConfigWatcher.h"
+#include "SIGA/MagnitudeCurve.h"
+#include "SIGA/SlowMotion.h"
+
+#include <fstream>
+#include <thread>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t POLLS = 20000;
+
+        std::string MakeIni(bool a_bowEnabled, float a_bowNovice) {
+            char text[512];
+            std::snprintf(text, sizeof(text),
+                "[General]\n"
+                "bEnabled = true\n"
+                "bApplyToNPCs = true\n"
+                "bEnableBowDebuff = %s\n"
+                "bEnableCastDebuff = true\n"
+                "\n"
+                "[Bow]\n"
+                "fNoviceMultiplier = %g\n",
+                a_bowEnabled ? "true" : "false", a_bowNovice);
+            return text;
+        }
+
+        void WriteFile(const std::filesystem::path& a_path, const std::string& a_text) {
+            std::ofstream file(a_path, std::ios::binary | std::ios::trunc);
+            file << a_text;
+        }
+
+        bool Check(const char* a_name, bool a_ok) {
+            std::printf("    %s: %s\n", a_name, a_ok ? "ok" : "MISMATCH");
+            return a_ok;
+        }
+    }
+
+    bool RunReloadBenchmarks() {
+        auto& fixture = Fixture::Get();
+        auto config = Config::GetSingleton();
+        auto watcher = ConfigWatcher::GetSingleton();
+        auto slowMgr = SlowMotionManager::GetSingleton();
+        auto original = *config->GetSnapshot();
+
+        auto directory = std::filesystem::temp_directory_path() / "siga_reload_bench";
+        std::filesystem::create_directories(directory);
+        auto path = directory / "SIGA.ini";
+
+        auto initial = MakeIni(true, 0.5f);
+        WriteFile(path, initial);
+        config->Publish(*Config::Parse(initial));
+        fixture.Reset();
+
+        PrintHeader("Config hot reload");
+        bool passed = true;
+
+        // What the watcher thread costs while nothing changes: one stat per interval
+        watcher->Start(path, std::chrono::milliseconds(0));
+        std::size_t reloads = 0;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < POLLS; ++i) {
+            reloads += watcher->Poll();
+        }
+        PrintResult("Poll/unchanged file", POLLS, Clock::now() - start, 0);
+        passed &= Check("unchanged file never reloads", reloads == 0);
+
+        // A file caught mid-write keeps the current settings
+        auto before = config->GetSnapshot();
+        WriteFile(path, "[Bow]\nfNoviceMultiplier = 0.3\n");
+        reloads = watcher->Poll();
+        reloads += watcher->Poll();
+        passed &= Check("incomplete file is rejected", reloads == 0 && config->GetSnapshot() == before);
+
+        // At startup there is no current file to keep, so the same text fills in the defaults
+        auto partial = Config::Parse("[Bow]\nfNoviceMultiplier = 0.3\n");
+        passed &= Check("partial file loads at startup", partial && partial->bowMultipliers[0] == 0.3f &&
+            partial->enableBowDebuff && partial->castMultipliers[0] == 0.5f);
+
+        // Disable the bow debuff while every NPC holds a bow and a cast slowdown
+        for (auto npc : fixture.npcs) {
+            slowMgr->ApplySlowdown(npc, SlowType::Bow, 20.0f);
+            slowMgr->ApplySlowdown(npc, SlowType::CastLeft, 20.0f);
+        }
+        fixture.Frame();
+        RE::Mock::ResetEngineCallCounters();
+
+        WriteFile(path, MakeIni(false, 0.3f));
+        bool settled = !watcher->Poll();
+        bool reloaded = watcher->Poll();
+        auto snapshot = config->GetSnapshot();
+        passed &= Check("change published after it settles",
+            settled && reloaded && !snapshot->enableBowDebuff && snapshot->bowMultipliers[0] == 0.3f);
+
+        fixture.Frame();
+        fixture.Frame();
+        auto& counters = RE::Mock::GetEngineCallCounters();
+        bool castsKept = true;
+        for (auto npc : fixture.npcs) {
+            castsKept &= slowMgr->IsActorSlowed(npc) && npc->GetMagicTarget()->activeEffects.size() == 1;
+        }
+        passed &= Check("disabled bow slowdowns cleared, casts kept",
+            counters.dispelEffect.load() == fixture.npcs.size() && castsKept);
+
+        // The same through the watcher thread
+        watcher->Start(path, std::chrono::milliseconds(5));
+        WriteFile(path, MakeIni(true, 0.4f));
+        auto deadline = Clock::now() + std::chrono::seconds(5);
+        auto count = watcher->GetReloadCount();
+        while (watcher->GetReloadCount() == count && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        fixture.Frame();
+        snapshot = config->GetSnapshot();
+        passed &= Check("watcher thread reloads", snapshot->enableBowDebuff && snapshot->bowMultipliers[0] == 0.4f);
+
+        // The novice bow spell now carries the reloaded magnitude, not the one from kDataLoaded
+        auto npc = fixture.npcs[0];
+        slowMgr->ApplySlowdown(npc, SlowType::Bow, 20.0f);
+        fixture.Frame();
+        auto& effects = npc->GetMagicTarget()->activeEffects;
+        auto expected = MagnitudeCurve::MagnitudeFromMultiplier(0.4f);
+        auto bowSpell = effects.empty() ? nullptr : effects.back()->spell;
+        passed &= Check("tier spells re-stamped", bowSpell && !bowSpell->effects.empty() &&
+            bowSpell->effects[0]->effectItem.magnitude == expected && effects.back()->magnitude == expected);
+
+        watcher->Stop();
+        config->Publish(std::move(original));
+        slowMgr->ApplyConfigChange(*snapshot, *config->GetSnapshot());
+        fixture.Reset();
+        std::filesystem::remove_all(directory);
+        return passed;
+    }
+}
@@ -0,0 +1,127 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/SkillCache.h"
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t CAST_ROUNDS = 1 << 15;
+
+        template <class Lookup>
+        void BenchLookup(std::string_view a_name, const std::vector<RE::Actor*>& a_actors, Lookup&& a_lookup) {
+            float total = 0.0f;
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < CAST_ROUNDS; ++round) {
+                for (auto actor : a_actors) {
+                    total += a_lookup(actor);
+                }
+            }
+            auto elapsed = Clock::now() - start;
+            DoNotOptimize(total);
+            PrintResult(a_name, CAST_ROUNDS * a_actors.size(), elapsed, 0);
+        }
+
+        float EngineMagicAverage(RE::Actor* a_actor) {
+            auto avOwner = a_actor->AsActorValueOwner();
+            float total = 0.0f;
+            total += avOwner->GetActorValue(RE::ActorValue::kDestruction);
+            total += avOwner->GetActorValue(RE::ActorValue::kRestoration);
+            total += avOwner->GetActorValue(RE::ActorValue::kAlteration);
+            total += avOwner->GetActorValue(RE::ActorValue::kConjuration);
+            total += avOwner->GetActorValue(RE::ActorValue::kIllusion);
+            return total * 0.2f;
+        }
+
+        // Each load brings its own actors, who never unregister, and whose handles are not
+        // reused here; the load drops their rows, so later loads' actors are still cached
+        bool CheckLoads(SkillCache* a_cache) {
+            constexpr std::uint32_t LOADS = 4;
+            constexpr std::uint32_t ACTORS_PER_LOAD = 512;
+
+            std::vector<std::unique_ptr<RE::Actor>> actors;
+            bool cached = true;
+            for (std::uint32_t load = 0; load < LOADS; ++load) {
+                a_cache->ResetRefreshCount();
+                for (std::uint32_t i = 0; i < ACTORS_PER_LOAD; ++i) {
+                    auto& actor = actors.emplace_back(std::make_unique<RE::Actor>());
+                    actor->formID = 0xFF030000 + load * ACTORS_PER_LOAD + i;
+                    RE::TESForm::RegisterForm(actor.get());
+                    DoNotOptimize(a_cache->GetSkill(actor.get(), RE::ActorValue::kArchery));
+                    DoNotOptimize(a_cache->GetSkill(actor.get(), RE::ActorValue::kArchery));
+                }
+                cached &= a_cache->GetRefreshCount() == ACTORS_PER_LOAD;
+                a_cache->Clear();
+            }
+            for (auto& actor : actors) {
+                RE::Mock::ReleaseHandle(actor.get());
+                RE::TESForm::UnregisterForm(actor.get());
+            }
+            std::printf("    %u loads of %u actors, each load's actors cached: %s\n", LOADS, ACTORS_PER_LOAD,
+                cached ? "ok" : "MISMATCH");
+            return cached;
+        }
+    }
+
+    bool RunSkillBenchmarks() {
+        auto& fixture = Fixture::Get();
+        fixture.Reset();
+
+        auto cache = SkillCache::GetSingleton();
+        cache->InvalidateAll();
+        std::vector<RE::Actor*> actors{ fixture.player };
+        actors.insert(actors.end(), fixture.npcs.begin(), fixture.npcs.end());
+
+        PrintHeader("Skill cache");
+
+        // GetMagicSkillLevel for a spell with no school, and for a Destruction spell
+        BenchLookup("unschooled cast/5 GetActorValue", actors, EngineMagicAverage);
+        cache->ResetRefreshCount();
+        BenchLookup("unschooled cast/cached", actors, [cache](RE::Actor* a_actor) { return cache->GetMagicAverage(a_actor); });
+        BenchLookup("school cast/GetActorValue", actors,
+            [](RE::Actor* a_actor) { return a_actor->AsActorValueOwner()->GetActorValue(RE::ActorValue::kDestruction); });
+        BenchLookup("school cast/cached", actors,
+            [cache](RE::Actor* a_actor) { return cache->GetSkill(a_actor, RE::ActorValue::kDestruction); });
+
+        bool matches = true;
+        for (auto actor : actors) {
+            matches &= cache->GetMagicAverage(actor) == EngineMagicAverage(actor) &&
+                       cache->GetSkill(actor, RE::ActorValue::kArchery) == actor->AsActorValueOwner()->GetActorValue(RE::ActorValue::kArchery);
+        }
+        auto refreshes = cache->GetRefreshCount();
+        bool cached = matches && refreshes == actors.size();
+        std::printf("    %llu refreshes for %zu actors, values match: %s\n", static_cast<unsigned long long>(refreshes),
+            actors.size(), cached ? "ok" : "MISMATCH");
+
+        // The player's skill-up refreshes only the player; a level-up refreshes everyone
+        auto player = fixture.player;
+        auto npc = fixture.npcs.front();
+        auto playerSkill = player->AsActorValueOwner()->GetActorValue(RE::ActorValue::kDestruction);
+        auto npcSkill = npc->AsActorValueOwner()->GetActorValue(RE::ActorValue::kDestruction);
+        player->AsActorValueOwner()->SetValue(RE::ActorValue::kDestruction, playerSkill + 1.0f);
+        npc->AsActorValueOwner()->SetValue(RE::ActorValue::kDestruction, npcSkill + 1.0f);
+
+        RE::SkillIncrease::Event skillUp{ player, RE::ActorValue::kDestruction };
+        cache->ProcessEvent(&skillUp, nullptr);
+        bool skillUpSeen = cache->GetSkill(player, RE::ActorValue::kDestruction) == playerSkill + 1.0f &&
+                           cache->GetSkill(npc, RE::ActorValue::kDestruction) == npcSkill;
+
+        RE::LevelIncrease::Event levelUp{ player, 10 };
+        cache->ProcessEvent(&levelUp, nullptr);
+        bool levelUpSeen = cache->GetSkill(npc, RE::ActorValue::kDestruction) == npcSkill + 1.0f;
+
+        // Fortify gear or a potion goes through an equip
+        npc->AsActorValueOwner()->SetValue(RE::ActorValue::kDestruction, npcSkill + 2.0f);
+        RE::TESEquipEvent equip{ npc, fixture.bow->GetFormID(), 0, 0, true };
+        cache->ProcessEvent(&equip, nullptr);
+        bool equipSeen = cache->GetSkill(npc, RE::ActorValue::kDestruction) == npcSkill + 2.0f;
+
+        std::printf("    skill up refreshes the player only: %s, level up refreshes NPCs: %s, equip refreshes: %s\n",
+            skillUpSeen ? "ok" : "MISMATCH", levelUpSeen ? "ok" : "MISMATCH", equipSeen ? "ok" : "MISMATCH");
+
+        player->AsActorValueOwner()->SetValue(RE::ActorValue::kDestruction, playerSkill);
+        npc->AsActorValueOwner()->SetValue(RE::ActorValue::kDestruction, npcSkill);
+        bool loaded = CheckLoads(cache);
+        cache->InvalidateAll();
+        fixture.Reset();
+        return cached && skillUpSeen && levelUpSeen && equipSeen && loaded;
+    }
+}
@@ -0,0 +1,222 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/ActorSlotMap.h"
+#include "SIGA/SlowMotion.h"
+#include "SIGA/SlowdownTimers.h"
+
+#include <thread>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::uint32_t TABLE_CAPACITY = 4096;
+        constexpr std::size_t LOOKUP_ROUNDS = 1 << 10;
+        constexpr std::size_t RESOLVE_ROUNDS = 1 << 14;
+        constexpr std::uint32_t CHURN_ACTORS = TABLE_CAPACITY * 4;
+
+        // A temporary reference's FormID, handed out again once the first one is deleted
+        constexpr RE::FormID RECYCLED_FORMID = 0xFF000A00;
+
+        template <class Lookup>
+        void BenchLookup(std::string_view a_name, std::size_t a_keys, std::size_t a_rounds, Lookup&& a_lookup) {
+            std::uint32_t total = 0;
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < a_rounds; ++round) {
+                for (std::uint32_t i = 0; i < a_keys; ++i) {
+                    total += a_lookup(i);
+                }
+            }
+            auto elapsed = Clock::now() - start;
+            DoNotOptimize(total);
+            PrintResult(a_name, a_rounds * a_keys, elapsed, 0);
+        }
+
+        // Four maps' worth of handles come and go while a quarter of the map stays live: one
+        // in three reuses a departed handle's index with a new age, and every eighth insert
+        // is raced by four threads, so all three ways of giving a slot back are taken. The
+        // map must still take a full load afterwards.
+        bool CheckHandleChurn() {
+            auto map = std::make_unique<ActorSlotMap<TABLE_CAPACITY>>();
+            auto set = [](std::uint32_t) { return 1u; };
+            auto clear = [](std::uint32_t) { return 0u; };
+
+            std::vector<RE::ActorHandle> live;
+            for (std::uint32_t i = 0; i < TABLE_CAPACITY / 4; ++i) {
+                live.emplace_back(0x04000000 | (0x10000 + i));
+                map->Update(live.back(), true, set);
+            }
+
+            constexpr std::uint32_t AGE = 1u << 20;
+            bool inserted = true;
+            std::uint32_t racedInserts = 0;
+            for (std::uint32_t i = 0; i < CHURN_ACTORS; ++i) {
+                // A fresh index, or the one before it at a later age, as when the engine
+                // hands a deleted temporary reference's index out again
+                auto index = 0x20000 + i - (i % 3 == 2 ? 1 : 0);
+                RE::ActorHandle handle(0x04000000 | (i % 3 == 2 ? AGE : 0) | index);
+                if (i % 8 == 0) {
+                    std::array<std::jthread, 4> threads;
+                    for (auto& thread : threads) {
+                        thread = std::jthread([&] { map->Update(handle, true, set); });
+                    }
+                    for (auto& thread : threads) {
+                        thread.join();
+                    }
+                    ++racedInserts;
+                }
+                else {
+                    inserted &= map->Update(handle, true, set).has_value();
+                }
+                inserted &= map->Load(handle) == 1;
+                // The older handle at an index is not released; the next age evicts it
+                if (i % 3 != 1) {
+                    map->Update(handle, false, clear);
+                    inserted &= map->Release(handle);
+                }
+            }
+
+            bool kept = map->GetUsedSlots() < TABLE_CAPACITY;
+            for (auto handle : live) {
+                kept &= map->Load(handle) == 1;
+            }
+            // An actor with a state is not released
+            kept &= !map->Release(live.front()) && map->Load(live.front()) == 1;
+
+            // Every slot not held by a live actor is free again
+            bool refilled = true;
+            for (std::uint32_t i = 0; i < TABLE_CAPACITY - live.size(); ++i) {
+                refilled &= map->Update(RE::ActorHandle(0x04000000 | (0x80000 + i)), true, set).has_value();
+            }
+            refilled &= !map->Update(RE::ActorHandle(0x04000000 | 0xFFFFF), true, set).has_value();
+
+            bool ok = inserted && kept && refilled;
+            std::printf("    %u handles (%u raced) churned through %u slots, live actors kept, full load fits after: %s\n",
+                CHURN_ACTORS, racedInserts, TABLE_CAPACITY, ok ? "ok" : "MISMATCH");
+            return ok;
+        }
+
+        std::unique_ptr<RE::Actor> MakeTemporaryActor() {
+            auto actor = std::make_unique<RE::Actor>();
+            actor->formID = RECYCLED_FORMID;
+            actor->fullName = "Summoned Familiar";
+            actor->inCombat = true;
+            RE::TESForm::RegisterForm(actor.get());
+            return actor;
+        }
+
+        void DeleteTemporaryActor(RE::Actor* a_actor) {
+            RE::Mock::ReleaseHandle(a_actor);
+            RE::TESForm::UnregisterForm(a_actor);
+        }
+
+        // A long session through the live tables: four tables' worth of NPCs each draw, loose
+        // and leave, a second after the last, with the stuck-slowdown wheel ticking along.
+        // Every other one is deleted at once, so the next reuses its handle index.
+        bool CheckSessionChurn(Fixture& a_fixture) {
+            auto slowMgr = SlowMotionManager::GetSingleton();
+            auto timers = SlowdownTimers::GetSingleton();
+            auto config = *Config::GetSingleton()->GetSnapshot();
+            config.stuckSlowdownTimeout = 1.0f;
+
+            std::vector<std::unique_ptr<RE::Actor>> actors;
+            bool slowed = true;
+            bool released = true;
+            for (std::uint32_t i = 0; i < CHURN_ACTORS; ++i) {
+                auto& actor = actors.emplace_back(std::make_unique<RE::Actor>());
+                actor->formID = 0xFF020000 + i;
+                actor->inCombat = true;
+                RE::TESForm::RegisterForm(actor.get());
+
+                slowMgr->ApplySlowdown(actor.get(), SlowType::Bow, 50.0f, &config);
+                a_fixture.Frame();
+                slowed &= slowMgr->IsActorSlowed(actor.get()) && actor->GetMagicTarget()->activeEffects.size() == 1;
+                slowMgr->RemoveSlowdown(actor.get(), SlowType::Bow);
+                a_fixture.Frame();
+                released &= !slowMgr->IsActorSlowed(actor.get()) && actor->GetMagicTarget()->activeEffects.empty();
+                timers->Tick();
+
+                if (i % 2 == 0) {
+                    DeleteTemporaryActor(actor.get());
+                }
+            }
+            for (auto& actor : actors) {
+                DeleteTemporaryActor(actor.get());
+            }
+            bool disarmed = timers->GetArmedCount() <= 10;
+
+            bool ok = slowed && released && disarmed;
+            std::printf("    %u NPCs slowed and released in one session, stuck timers disarmed: %s\n", CHURN_ACTORS,
+                ok ? "ok" : "MISMATCH");
+            timers->Clear();
+            return ok;
+        }
+    }
+
+    bool RunSlotBenchmarks() {
+        auto& fixture = Fixture::Get();
+        fixture.Reset();
+
+        PrintHeader("Actor slot map");
+
+        // IsActorSlowed and every state update: two array reads by handle, with the map a
+        // quarter full and with it nearly full in a long battle, and for an actor it lacks
+        for (auto tracked : { TABLE_CAPACITY / 4, TABLE_CAPACITY - TABLE_CAPACITY / 8 }) {
+            auto byHandle = std::make_unique<ActorSlotMap<TABLE_CAPACITY>>();
+            std::vector<RE::ActorHandle> handles;
+            std::vector<RE::ActorHandle> absent;
+            for (std::uint32_t i = 0; i < tracked; ++i) {
+                handles.emplace_back(0x04000100 + i * 7);
+                absent.emplace_back(0x04000100 + i * 7 + 3);
+                byHandle->Update(handles.back(), true, [](std::uint32_t) { return 1u; });
+            }
+            auto rounds = LOOKUP_ROUNDS * TABLE_CAPACITY / 4 / tracked;
+            char name[64];
+            std::snprintf(name, sizeof(name), "state lookup, %u actors/present", tracked);
+            BenchLookup(name, tracked, rounds, [&](std::uint32_t i) { return byHandle->Load(handles[i]); });
+            std::snprintf(name, sizeof(name), "state lookup, %u actors/absent", tracked);
+            BenchLookup(name, tracked, rounds, [&](std::uint32_t i) { return byHandle->Load(absent[i]); });
+        }
+
+        // What ClearAll and each flush pay to get from a stored key back to the actor
+        std::vector<RE::Actor*> actors{ fixture.player };
+        actors.insert(actors.end(), fixture.npcs.begin(), fixture.npcs.end());
+        std::vector<RE::ActorHandle> actorHandles;
+        for (auto actor : actors) {
+            actorHandles.push_back(actor->GetHandle());
+        }
+        BenchLookup("resolve actor/LookupByID", actors.size(), RESOLVE_ROUNDS,
+            [&](std::uint32_t i) { return RE::TESForm::LookupByID<RE::Actor>(actors[i]->GetFormID()) != nullptr; });
+        BenchLookup("resolve actor/handle", actors.size(), RESOLVE_ROUNDS,
+            [&](std::uint32_t i) { return static_cast<bool>(actorHandles[i].get()); });
+
+        bool churned = CheckHandleChurn();
+        churned &= CheckSessionChurn(fixture);
+
+        // A slowed temporary actor is deleted and its FormID and handle index reused
+        auto slowMgr = SlowMotionManager::GetSingleton();
+        auto first = MakeTemporaryActor();
+        auto firstHandle = first->GetHandle();
+        slowMgr->ApplySlowdown(first.get(), SlowType::Bow, 50.0f);
+        fixture.Frame();
+        DeleteTemporaryActor(first.get());
+
+        auto second = MakeTemporaryActor();
+        auto secondHandle = second->GetHandle();
+        bool reused = (secondHandle.native_handle() & 0xFFFFF) == (firstHandle.native_handle() & 0xFFFFF) && secondHandle != firstHandle;
+        bool freshState = !slowMgr->IsActorSlowed(second.get()) && !firstHandle.get();
+
+        // Its own slowdown applies, and a clear-all skips the deleted one without a form lookup
+        slowMgr->ApplySlowdown(second.get(), SlowType::CastLeft, 50.0f);
+        fixture.Frame();
+        bool ownEffect = second->GetMagicTarget()->activeEffects.size() == 1;
+        slowMgr->ClearAll();
+        bool cleared = second->GetMagicTarget()->activeEffects.empty() && !slowMgr->IsActorSlowed(second.get());
+        DeleteTemporaryActor(second.get());
+
+        bool ok = reused && freshState && ownEffect && cleared && churned;
+        std::printf("    recycled 0xFF actor starts clean: %s, gets its own effect: %s, cleared: %s\n",
+            reused && freshState ? "ok" : "MISMATCH", ownEffect ? "ok" : "MISMATCH", cleared ? "ok" : "MISMATCH");
+
+        fixture.Reset();
+        return ok;
+    }
+}
@@ -0,0 +1,115 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/SpellIndex.h"
+
+#include <random>
+
+namespace SIGA::Bench {
+    namespace {
+        // Roughly a heavily modded load order's spell count, spread over plugins whose local
+        // FormIDs overlap, as real plugins' do
+        constexpr std::size_t PLUGIN_COUNT = 20;
+        constexpr std::size_t SPELLS_PER_PLUGIN = 1000;
+        constexpr std::size_t SPELL_COUNT = PLUGIN_COUNT * SPELLS_PER_PLUGIN;
+        constexpr RE::FormID FIRST_PLUGIN = 0x05;
+        constexpr std::size_t LOOKUPS = 1 << 20;
+
+        struct SpellSet {
+            std::vector<std::unique_ptr<RE::SpellItem>> spells;
+            std::vector<std::unique_ptr<RE::Effect>> effects;
+            std::vector<std::unique_ptr<RE::EffectSetting>> baseEffects;
+        };
+
+        // Spells of one to six effects, each with its own base effect as in a real load order;
+        // about one in fifty has a SpeedMult effect, last
+        void MakeSpells(SpellSet& a_set) {
+            constexpr RE::ActorValue SCHOOLS[] = { RE::ActorValue::kNone, RE::ActorValue::kDestruction, RE::ActorValue::kRestoration,
+                RE::ActorValue::kAlteration, RE::ActorValue::kConjuration, RE::ActorValue::kIllusion };
+
+            std::mt19937 rng(0x5E11u);
+            auto& forms = RE::TESDataHandler::GetSingleton()->GetFormArray<RE::SpellItem>();
+            for (std::size_t i = 0; i < SPELL_COUNT; ++i) {
+                auto& spell = a_set.spells.emplace_back(std::make_unique<RE::SpellItem>());
+                auto plugin = FIRST_PLUGIN + static_cast<RE::FormID>(i / SPELLS_PER_PLUGIN);
+                spell->formID = plugin << 24 | (0x800 + static_cast<RE::FormID>(i % SPELLS_PER_PLUGIN));
+                spell->associatedSkill = SCHOOLS[rng() % std::size(SCHOOLS)];
+                spell->data.castingType = rng() % 3 == 0 ? RE::MagicSystem::CastingType::kConcentration : RE::MagicSystem::CastingType::kFireAndForget;
+
+                auto effectCount = 1 + rng() % 6;
+                bool speed = rng() % 50 == 0;
+                for (std::uint32_t e = 0; e < effectCount; ++e) {
+                    auto& effect = a_set.effects.emplace_back(std::make_unique<RE::Effect>());
+                    auto& baseEffect = a_set.baseEffects.emplace_back(std::make_unique<RE::EffectSetting>());
+                    baseEffect->data.primaryAV = (speed && e + 1 == effectCount) ? RE::ActorValue::kSpeedMult : RE::ActorValue::kDestruction;
+                    effect->baseEffect = baseEffect.get();
+                    spell->effects.push_back(effect.get());
+                }
+                forms.push_back(spell.get());
+            }
+        }
+
+        template <class Lookup>
+        void BenchLookup(std::string_view a_name, const SpellSet& a_set, Lookup&& a_lookup) {
+            std::uint32_t speed = 0;
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < LOOKUPS; ++i) {
+                speed += a_lookup(a_set.spells[(i * 7919) % a_set.spells.size()].get());
+            }
+            auto elapsed = Clock::now() - start;
+            DoNotOptimize(speed);
+            PrintResult(a_name, LOOKUPS, elapsed, 0);
+        }
+
+        bool SameInfo(const SpellIndex::Info& a, const SpellIndex::Info& b) {
+            return a.school == b.school && a.modifiesSpeed == b.modifiesSpeed && a.concentration == b.concentration;
+        }
+    }
+
+    bool RunSpellBenchmarks() {
+        auto index = SpellIndex::GetSingleton();
+        if (index->IsReady()) {
+            std::printf("\n== Spell index\n    already built in this run; skipped\n");
+            return true;
+        }
+
+        SpellSet set;
+        MakeSpells(set);
+
+        PrintHeader("Spell index");
+
+        // Before the index is published, BeginCast takes the same walk as it always did
+        BenchLookup("BeginCast spell info/effect walk", set, [](RE::SpellItem* a_spell) { return SpellIndex::Scan(a_spell).modifiesSpeed; });
+
+        auto start = Clock::now();
+        index->BuildAsync();
+        index->Wait();
+        PrintResult("index build (all spells)", set.spells.size(), Clock::now() - start, 0);
+
+        BenchLookup("BeginCast spell info/index", set, [index](RE::SpellItem* a_spell) { return index->Describe(a_spell)->modifiesSpeed; });
+
+        std::size_t mismatches = 0;
+        std::size_t speedSpells = 0;
+        std::size_t concentrationSpells = 0;
+        for (auto& spell : set.spells) {
+            auto described = index->Describe(spell.get());
+            auto scanned = SpellIndex::Scan(spell.get());
+            mismatches += !described || !SameInfo(*described, scanned);
+            speedSpells += scanned.modifiesSpeed;
+            concentrationSpells += scanned.concentration;
+        }
+        auto& fixture = Fixture::Get();
+        bool notSpell = !index->Describe(nullptr);
+        bool ok = index->IsReady() && mismatches == 0 && notSpell && concentrationSpells > 0 && concentrationSpells < set.spells.size() &&
+                  index->Describe(fixture.destructionSpell)->school == RE::ActorValue::kDestruction;
+        std::printf("    %zu spells, %zu modify speed, %zu concentration, %zu differ from the walk: %s\n", set.spells.size(),
+            speedSpells, concentrationSpells, mismatches, ok ? "ok" : "MISMATCH");
+
+        // The index keeps these FormIDs; nothing else in the run uses them
+        auto& forms = RE::TESDataHandler::GetSingleton()->GetFormArray<RE::SpellItem>();
+        std::erase_if(forms, [](RE::SpellItem* a_spell) {
+            auto plugin = a_spell->GetFormID() >> 24;
+            return plugin >= FIRST_PLUGIN && plugin < FIRST_PLUGIN + PLUGIN_COUNT;
+        });
+        return ok;
+    }
+}
@@ -0,0 +1,70 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/AnimEventTags.h"
+#include "SIGA/TagClassifier.h"
+
+#include <unordered_map>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t STREAM_LENGTH = 1 << 16;
+        constexpr std::size_t PASSES = 64;
+
+        // The lookup ProcessEvent used before the perfect hash
+        const std::unordered_map<std::string_view, AnimEventType> EVENT_LOOKUP = {
+            { "BowDrawn", AnimEventType::BowDrawn },
+            { "bowRelease", AnimEventType::BowRelease },
+            { "BeginCastLeft", AnimEventType::BeginCastLeft },
+            { "BeginCastRight", AnimEventType::BeginCastRight },
+            { "CastStop", AnimEventType::CastStop },
+            { "CastOKStop", AnimEventType::CastOKStop },
+            { "InterruptCast", AnimEventType::InterruptCast },
+            { "attackStop", AnimEventType::AttackStop },
+            { "WeaponSheathe", AnimEventType::WeaponSheathe },
+            { "weaponSheathe", AnimEventType::WeaponSheathe },
+        };
+
+        template <class Classifier>
+        void BenchClassifier(std::string_view a_name, const std::vector<RE::BSAnimationGraphEvent>& a_stream, Classifier&& a_classify) {
+            std::uint64_t hits = 0;
+            auto start = Clock::now();
+            for (std::size_t pass = 0; pass < PASSES; ++pass) {
+                for (auto& event : a_stream) {
+                    auto type = a_classify(event.tag);
+                    DoNotOptimize(type);
+                    hits += type != AnimEventType::Unknown;
+                }
+            }
+            auto elapsed = Clock::now() - start;
+
+            PrintResult(a_name, a_stream.size() * PASSES, elapsed, 0);
+            std::printf("    hit rate %.2f%%\n", 100.0 * static_cast<double>(hits) / static_cast<double>(a_stream.size() * PASSES));
+        }
+    }
+
+    bool RunTagBenchmarks() {
+        auto stream = Fixture::Get().MakeEventStream(STREAM_LENGTH);
+
+        PrintHeader("Tag classification");
+        BenchClassifier("unordered_map (string_view from c_str)", stream, [](const RE::BSFixedString& a_tag) {
+            std::string_view name = a_tag.c_str();
+            auto it = EVENT_LOOKUP.find(name);
+            return it != EVENT_LOOKUP.end() ? it->second : AnimEventType::Unknown;
+        });
+        BenchClassifier("perfect hash (cached length)", stream, [](const RE::BSFixedString& a_tag) {
+            return AnimEventTags::Classify(a_tag.data(), a_tag.size());
+        });
+
+        auto classifier = TagClassifier::GetSingleton();
+        classifier->ResetStats();
+        BenchClassifier("interned pointer cache", stream, [classifier](const RE::BSFixedString& a_tag) {
+            return classifier->Classify(a_tag);
+        });
+        auto stats = classifier->GetStats();
+        std::printf("    pointer hits %llu, cache fills %llu, string fallbacks %llu\n",
+            static_cast<unsigned long long>(stats.pointerHits),
+            static_cast<unsigned long long>(stats.cacheFills),
+            static_cast<unsigned long long>(stats.stringFallbacks));
+        return true;
+    }
+}
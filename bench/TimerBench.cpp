@@ -0,0 +1,118 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/SlowMotion.h"
+#include "SIGA/SlowdownTimers.h"
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t RENEW_ROUNDS = 1 << 15;
+        constexpr std::size_t ARMED_ACTORS = 2048;
+        constexpr std::size_t IDLE_TICKS = 4096;
+
+        // Handles of actors the timers know nothing else about; none of them is slowed
+        constexpr std::uint32_t SYNTHETIC_BASE = 0x04000800;
+
+        std::size_t TickTimes(SlowdownTimers* a_timers, std::size_t a_ticks) {
+            std::size_t cleared = 0;
+            for (std::size_t i = 0; i < a_ticks; ++i) {
+                cleared += a_timers->Tick();
+            }
+            return cleared;
+        }
+    }
+
+    bool RunTimerBenchmarks() {
+        auto& fixture = Fixture::Get();
+        fixture.Reset();
+
+        auto timers = SlowdownTimers::GetSingleton();
+        auto slowMgr = SlowMotionManager::GetSingleton();
+        timers->Clear();
+
+        // One tick per 100 ms; 1 s is ten ticks, 20 s goes through the far wheel
+        auto config = *Config::GetSingleton()->GetSnapshot();
+        config.stuckSlowdownTimeout = 1.0f;
+        constexpr std::size_t TIMEOUT_TICKS = 10;
+
+        PrintHeader("Slowdown timers");
+
+        for (auto npc : fixture.npcs) {
+            slowMgr->ApplySlowdown(npc, SlowType::Bow, 50.0f, &config);
+        }
+        fixture.Frame();
+
+        // What an animation event from a slowed and an unslowed actor now pays
+        auto start = Clock::now();
+        for (std::size_t round = 0; round < RENEW_ROUNDS; ++round) {
+            for (auto npc : fixture.npcs) {
+                timers->Renew(npc->GetHandle(), config.stuckSlowdownTimeout);
+            }
+        }
+        PrintResult("event renews slowed actor", RENEW_ROUNDS * fixture.npcs.size(), Clock::now() - start, 0);
+
+        start = Clock::now();
+        for (std::size_t round = 0; round < RENEW_ROUNDS; ++round) {
+            for (auto npc : fixture.npcs) {
+                timers->Renew(RE::ActorHandle(npc->GetHandle().native_handle() + 0x100), config.stuckSlowdownTimeout);
+            }
+        }
+        PrintResult("event from unslowed actor", RENEW_ROUNDS * fixture.npcs.size(), Clock::now() - start, 0);
+
+        // NPC 0 keeps casting; the rest lost their release event and must be cleared on time
+        auto active = fixture.npcs.front();
+        std::size_t early = 0;
+        for (std::size_t tick = 1; tick < TIMEOUT_TICKS; ++tick) {
+            timers->Renew(active->GetHandle(), config.stuckSlowdownTimeout);
+            early += timers->Tick();
+        }
+        timers->Renew(active->GetHandle(), config.stuckSlowdownTimeout);
+        auto cleared = timers->Tick();
+        fixture.Frame();
+
+        bool expiredOnTime = early == 0 && cleared == fixture.npcs.size() - 1 && slowMgr->IsActorSlowed(active);
+        for (std::size_t i = 1; i < fixture.npcs.size(); ++i) {
+            expiredOnTime &= !slowMgr->IsActorSlowed(fixture.npcs[i]);
+        }
+        std::printf("    %zu of %zu stuck NPCs cleared after %zu ticks, none early, active NPC kept: %s\n", cleared,
+            fixture.npcs.size() - 1, TIMEOUT_TICKS, expiredOnTime ? "ok" : "MISMATCH");
+
+        // A long deadline waits in the far wheel, and a normal release leaves nothing to clear
+        config.stuckSlowdownTimeout = 20.0f;
+        auto farNpc = fixture.npcs[1];
+        auto releasedNpc = fixture.npcs[2];
+        slowMgr->ApplySlowdown(farNpc, SlowType::Bow, 50.0f, &config);
+        slowMgr->ApplySlowdown(releasedNpc, SlowType::Bow, 50.0f, &config);
+        slowMgr->RemoveSlowdown(releasedNpc, SlowType::Bow);
+        slowMgr->RemoveSlowdown(active, SlowType::Bow);
+        fixture.Frame();
+        early = TickTimes(timers, 199);
+        bool farKept = slowMgr->IsActorSlowed(farNpc);
+        cleared = timers->Tick();
+        fixture.Frame();
+        bool farExpired = early == 0 && farKept && cleared == 1 && !slowMgr->IsActorSlowed(farNpc);
+        std::printf("    20 s deadline cleared at tick 200 exactly, released actor not counted: %s\n", farExpired ? "ok" : "MISMATCH");
+
+        // Tick cost while many actors are armed far ahead, and for a tick where they all fall due
+        timers->Clear();
+        for (std::size_t i = 0; i < ARMED_ACTORS; ++i) {
+            timers->Arm(RE::ActorHandle(SYNTHETIC_BASE + static_cast<std::uint32_t>(i)), 300.0f);
+        }
+        start = Clock::now();
+        TickTimes(timers, IDLE_TICKS);
+        PrintResult("tick, 2048 armed, none due", IDLE_TICKS, Clock::now() - start, 0);
+
+        timers->Clear();
+        for (std::size_t i = 0; i < ARMED_ACTORS; ++i) {
+            timers->Arm(RE::ActorHandle(SYNTHETIC_BASE + static_cast<std::uint32_t>(i)), 0.1f);
+        }
+        start = Clock::now();
+        timers->Tick();
+        PrintResult("tick, 2048 due (per actor)", ARMED_ACTORS, Clock::now() - start, 0);
+        bool drained = timers->GetArmedCount() == 0;
+        std::printf("    every due actor disarmed in one tick: %s\n", drained ? "ok" : "MISMATCH");
+
+        timers->Clear();
+        fixture.Reset();
+        return expiredOnTime && farExpired && drained;
+    }
+}
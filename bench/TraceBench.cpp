@@ -0,0 +1,149 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/AnimationHandler.h"
+#include "SIGA/TraceLog.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t RECORD_CALLS = 1 << 20;
+        constexpr std::size_t RECORD_BATCH = 4096;  // Drained between batches, untimed
+        constexpr std::size_t STREAM_LENGTH = 1 << 16;
+        constexpr std::size_t EVENTS_PER_FRAME = 256;
+
+        // a_trace, if given, receives the stream's records and nothing from before it
+        void BenchProcessEvent(std::string_view a_name, const std::vector<RE::BSAnimationGraphEvent>& a_stream,
+            const std::filesystem::path* a_trace = nullptr, TraceLog::OutputFormat a_format = TraceLog::OutputFormat::kBinary) {
+            auto& fixture = Fixture::Get();
+            fixture.Reset();
+            if (a_trace) {
+                TraceLog::GetSingleton()->SetOutput(*a_trace, a_format);
+                TraceLog::GetSingleton()->SetEnabled(true);
+            }
+
+            // The stream runs far faster than frames do; the writer thread's drain is played
+            // once per frame, untimed, as it would keep up in game
+            auto handler = AnimationEventHandler::GetSingleton();
+            Clock::duration elapsed{};
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < a_stream.size(); ++i) {
+                handler->ProcessEvent(&a_stream[i], nullptr);
+                if ((i + 1) % EVENTS_PER_FRAME == 0) {
+                    fixture.Frame();
+                    elapsed += Clock::now() - start;
+                    TraceLog::GetSingleton()->Drain();
+                    start = Clock::now();
+                }
+            }
+            fixture.Frame();
+            elapsed += Clock::now() - start;
+            PrintResult(a_name, a_stream.size(), elapsed, EngineCalls());
+        }
+
+        // Every cast and dispel the engine saw must be in the file, and nothing dropped
+        bool CheckTraceFile(const std::filesystem::path& a_path) {
+            std::vector<Trace::Record> records;
+            Trace::FileHeader header;
+            if (auto file = std::fopen(a_path.string().c_str(), "rb")) {
+                if (std::fread(&header, sizeof(header), 1, file) == 1) {
+                    Trace::Record record;
+                    while (std::fread(&record, sizeof(record), 1, file) == 1) {
+                        records.push_back(record);
+                    }
+                }
+                std::fclose(file);
+            }
+
+            auto count = [&](Trace::Format a_format) {
+                return std::count_if(records.begin(), records.end(),
+                    [=](const Trace::Record& a_record) { return a_record.format == static_cast<std::uint16_t>(a_format); });
+            };
+
+            auto& counters = RE::Mock::GetEngineCallCounters();
+            auto casts = static_cast<std::uint64_t>(count(Trace::Format::kCastSpell));
+            auto dispels = static_cast<std::uint64_t>(count(Trace::Format::kDispelSpell));
+            auto events = static_cast<std::uint64_t>(count(Trace::Format::kAnimationEvent));
+            bool ok = std::memcmp(header.magic, Trace::FileHeader{}.magic, sizeof(header.magic)) == 0 &&
+                      casts == counters.castSpellImmediate.load() && dispels == counters.dispelEffect.load() &&
+                      count(Trace::Format::kDropped) == 0 && events > 0;
+            std::printf("    %zu records: %llu animation events, %llu casts, %llu dispels: %s\n", records.size(),
+                static_cast<unsigned long long>(events), static_cast<unsigned long long>(casts),
+                static_cast<unsigned long long>(dispels), ok ? "ok" : "MISMATCH");
+            return ok;
+        }
+
+        // Strict JSON, as many span ends as begins, and the slowdown spans present
+        bool CheckChromeFile(const std::filesystem::path& a_path) {
+            std::ifstream file(a_path);
+            std::stringstream stream;
+            stream << file.rdbuf();
+            auto text = stream.str();
+
+            auto count = [&](std::string_view a_needle) {
+                std::size_t result = 0;
+                for (auto pos = text.find(a_needle); pos != std::string::npos; pos = text.find(a_needle, pos + 1)) {
+                    ++result;
+                }
+                return result;
+            };
+
+            auto begins = count(R"("ph":"B")");
+            auto ends = count(R"("ph":"E")");
+            auto applies = count(R"("name":"ApplySlowdown")");
+            bool ok = text.starts_with("[\n") && text.ends_with("{}]\n") && begins == ends && applies > 0 &&
+                      count(R"("name":"Flush")") > 0;
+            std::printf("    %zu bytes, %zu spans, %zu ApplySlowdown: %s\n", text.size(), begins, applies, ok ? "ok" : "MISMATCH");
+            return ok;
+        }
+    }
+
+    bool RunTraceBenchmarks() {
+        auto& fixture = Fixture::Get();
+        auto trace = TraceLog::GetSingleton();
+        auto stream = fixture.MakeEventStream(STREAM_LENGTH);
+
+        auto directory = std::filesystem::temp_directory_path() / "siga_trace_bench";
+        std::filesystem::create_directories(directory);
+
+        PrintHeader("Binary trace");
+
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < RECORD_CALLS; ++i) {
+            trace->Record(Trace::Format::kApplySlowdown, static_cast<RE::FormID>(i), 0, 50.0f);
+        }
+        PrintResult("Record/disabled", RECORD_CALLS, Clock::now() - start, 0);
+
+        trace->SetOutput(directory / "records.trace");
+        trace->SetEnabled(true);
+        Clock::duration elapsed{};
+        for (std::size_t batch = 0; batch < RECORD_CALLS; batch += RECORD_BATCH) {
+            start = Clock::now();
+            for (std::size_t i = batch; i < batch + RECORD_BATCH; ++i) {
+                trace->Record(Trace::Format::kApplySlowdown, static_cast<RE::FormID>(i), 0, 50.0f);
+            }
+            elapsed += Clock::now() - start;
+            trace->Drain();
+        }
+        PrintResult("Record/enabled", RECORD_CALLS, elapsed, 0);
+        trace->Close();
+
+        BenchProcessEvent("ProcessEvent/binary trace off", stream);
+
+        auto path = directory / "stream.trace";
+        BenchProcessEvent("ProcessEvent/binary trace on", stream, &path);
+        trace->Close();
+        bool passed = CheckTraceFile(path);
+
+        auto chromePath = directory / "stream.json";
+        BenchProcessEvent("ProcessEvent/Chrome trace on", stream, &chromePath, TraceLog::OutputFormat::kChromeJson);
+        trace->Close();
+        passed &= CheckChromeFile(chromePath);
+
+        fixture.Reset();
+        std::filesystem::remove_all(directory);
+        return passed;
+    }
+}
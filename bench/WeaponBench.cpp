@@ -0,0 +1,75 @@
+#include "BenchFixture.h"
+#include "BenchHarness.h"
+#include "SIGA/WeaponCache.h"
+
+namespace SIGA::Bench {
+    namespace {
+        constexpr std::size_t DRAW_ROUNDS = 1 << 16;
+
+        template <class Lookup>
+        void BenchLookup(std::string_view a_name, const std::vector<RE::Actor*>& a_actors, Lookup&& a_lookup) {
+            std::uint32_t crossbows = 0;
+            auto start = Clock::now();
+            for (std::size_t round = 0; round < DRAW_ROUNDS; ++round) {
+                for (auto actor : a_actors) {
+                    crossbows += a_lookup(actor) == WeaponCache::Ranged::kCrossbow;
+                }
+            }
+            auto elapsed = Clock::now() - start;
+            DoNotOptimize(crossbows);
+            PrintResult(a_name, DRAW_ROUNDS * a_actors.size(), elapsed, 0);
+        }
+
+        void SendEquip(RE::Actor* a_actor, RE::TESForm* a_item, bool a_equipped) {
+            RE::TESEquipEvent event{ a_actor, a_item->GetFormID(), 0, 0, a_equipped };
+            WeaponCache::GetSingleton()->ProcessEvent(&event, nullptr);
+        }
+    }
+
+    bool RunWeaponBenchmarks() {
+        auto& fixture = Fixture::Get();
+        fixture.Reset();
+
+        auto cache = WeaponCache::GetSingleton();
+        std::vector<RE::Actor*> actors{ fixture.player };
+        actors.insert(actors.end(), fixture.npcs.begin(), fixture.npcs.end());
+
+        PrintHeader("Weapon cache");
+
+        // What OnBowDrawn paid on every draw, against the cached read. The mock's engine query
+        // is three inlined loads; in game GetEquippedObject goes through the actor's AI process.
+        BenchLookup("bow draw/GetEquippedObject + As + type", actors, WeaponCache::QueryEngine);
+        cache->ResetResolveCount();
+        BenchLookup("bow draw/cached", actors, [cache](RE::Actor* a_actor) { return cache->GetRanged(a_actor); });
+
+        // Registered NPCs were filled up front; only the player needed a first resolve
+        auto resolves = cache->GetResolveCount();
+        bool cached = resolves <= 1;
+        std::printf("    %llu engine queries for %zu draws: %s\n", static_cast<unsigned long long>(resolves),
+            DRAW_ROUNDS * actors.size(), cached ? "ok" : "MISMATCH");
+
+        // Swap a bow for the crossbow; the equip event makes the next draw see it
+        auto npc = fixture.npcs[1];
+        auto original = npc->equippedRight;
+        bool wasBow = cache->GetRanged(npc) == WeaponCache::Ranged::kBow;
+        SendEquip(npc, original, false);
+        npc->equippedRight = fixture.crossbow;
+        SendEquip(npc, fixture.crossbow, true);
+        bool nowCrossbow = cache->GetRanged(npc) == WeaponCache::Ranged::kCrossbow;
+
+        // A spell in the hand leaves no ranged weapon
+        npc->equippedRight = fixture.destructionSpell;
+        SendEquip(npc, fixture.destructionSpell, true);
+        bool nowNone = cache->GetRanged(npc) == WeaponCache::Ranged::kNone;
+
+        npc->equippedRight = original;
+        SendEquip(npc, original, true);
+        bool restored = cache->GetRanged(npc) == WeaponCache::QueryEngine(npc);
+
+        bool swapped = wasBow && nowCrossbow && nowNone && restored;
+        std::printf("    bow -> crossbow -> spell -> bow follows equip events: %s\n", swapped ? "ok" : "MISMATCH");
+
+        fixture.Reset();
+        return cached && swapped;
+    }
+}
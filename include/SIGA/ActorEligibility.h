@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace SIGA {
+    // Which NPCs may have their animation events acted on, one bit per hashed FormID.
+    // Combat events rebuild it; ProcessEvent tests it before any engine query. FormIDs that
+    // hash alike share a bit, so a set bit still needs confirming, but a clear one never does.
+    class ActorEligibility {
+    public:
+        static constexpr std::size_t BITS = 4096;
+
+        [[nodiscard]] bool Test(RE::FormID a_formID) const noexcept {
+            auto bit = BitOf(a_formID);
+            return (words[bit / 64].load(std::memory_order_relaxed) >> (bit % 64)) & 1;
+        }
+
+        // Replaces the whole set. Each word is stored in one go, so a concurrent Test sees
+        // either the old or the new bit, never a cleared word on its way to being refilled.
+        template <class Range>
+        void Assign(const Range& a_formIDs) noexcept {
+            std::array<std::uint64_t, BITS / 64> next{};
+            for (RE::FormID formID : a_formIDs) {
+                auto bit = BitOf(formID);
+                next[bit / 64] |= std::uint64_t{ 1 } << (bit % 64);
+            }
+            for (std::size_t i = 0; i < next.size(); ++i) {
+                words[i].store(next[i], std::memory_order_relaxed);
+            }
+        }
+
+        void Set(RE::FormID a_formID) noexcept {
+            auto bit = BitOf(a_formID);
+            words[bit / 64].fetch_or(std::uint64_t{ 1 } << (bit % 64), std::memory_order_relaxed);
+        }
+
+    private:
+        // Fibonacci hashing: load-order bits and the low reference bits both spread out
+        static std::uint32_t BitOf(RE::FormID a_formID) noexcept {
+            return (a_formID * 0x9E3779B1u) >> (32 - 12);
+        }
+
+        static_assert(BITS == 1u << 12);
+
+        std::array<std::atomic<std::uint64_t>, BITS / 64> words{};
+    };
+}
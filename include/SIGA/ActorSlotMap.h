@@ -0,0 +1,232 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace SIGA {
+    // Per-actor 32-bit state keyed by ActorHandle, as a generational slot map. The engine
+    // keeps each reference's handle-table index in the reference itself, and the handle
+    // carries an age that changes when the index is reused; the sparse array maps that
+    // index straight to a dense slot, and the slot holds the full handle. A lookup is two
+    // array reads, and a recycled reference - a temporary 0xFF actor whose FormID came
+    // back - simply fails the handle comparison. Slots are handed out densely in insertion
+    // order, so bulk passes walk a contiguous prefix, and each slot is one atomic word
+    // (handle << 32 | state) updated by CAS. Release() unlinks an actor whose state is back
+    // to 0 and puts its slot on a free list, which inserts take from before growing the
+    // prefix; a slot left behind by a reused handle index or a lost insert race goes back
+    // the same way, so a long session never runs the map dry.
+    template <std::uint32_t Capacity>
+    class ActorSlotMap {
+        static_assert(Capacity <= 0xFFFF, "Slots are stored as 16 bits in the sparse array");
+
+    public:
+        struct Transition {
+            std::uint32_t slot;  // Stable until Release() or Drain(); lets callers keep per-actor data alongside
+            std::uint32_t oldState;
+            std::uint32_t newState;
+        };
+
+        // Current state for an actor, 0 if it has none
+        [[nodiscard]] std::uint32_t Load(RE::ActorHandle a_handle) const {
+            auto slot = Find(a_handle);
+            return slot ? StateOf(slots[*slot].load(std::memory_order_acquire)) : 0;
+        }
+
+        // Atomically replaces the state with a_transition(state). Inserts the actor when
+        // a_insert is set and it has no slot yet. Returns the slot and both states, or
+        // nullopt when the actor is absent and not inserted, or the map is full.
+        template <class Fn>
+        std::optional<Transition> Update(RE::ActorHandle a_handle, bool a_insert, Fn&& a_transition) {
+            auto key = a_handle.native_handle();
+            while (true) {
+                auto slot = a_insert ? FindOrInsert(a_handle) : Find(a_handle);
+                if (!slot) {
+                    return std::nullopt;
+                }
+
+                auto& word = slots[*slot];
+                auto current = word.load(std::memory_order_acquire);
+                while (KeyOf(current) == key) {
+                    auto oldState = StateOf(current);
+                    auto newState = static_cast<std::uint32_t>(a_transition(oldState));
+                    if (newState == oldState ||
+                        word.compare_exchange_weak(current, Pack(key, newState), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        return Transition{ *slot, oldState, newState };
+                    }
+                }
+                // The slot was reclaimed by Release() or Drain() under us; look the actor up again
+            }
+        }
+
+        // Unlinks an actor whose state is 0 and frees its slot. False if the actor is absent
+        // or an update gave it a state again; an update racing the release re-inserts it.
+        bool Release(RE::ActorHandle a_handle) {
+            auto key = a_handle.native_handle();
+            auto slot = Find(a_handle);
+            if (!slot) {
+                return false;
+            }
+            auto expected = Pack(key, 0);
+            if (!slots[*slot].compare_exchange_strong(expected, 0, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return false;
+            }
+
+            // A newer handle for the same index may have been linked already; leave it be
+            auto entry = static_cast<std::uint16_t>(*slot + 1);
+            sparse[key & INDEX_MASK].compare_exchange_strong(entry, 0, std::memory_order_acq_rel, std::memory_order_relaxed);
+            PushFree(*slot);
+            return true;
+        }
+
+        // Visits every actor with a non-zero state, in slot order
+        template <class Visitor>
+        void ForEach(Visitor&& a_visitor) const {
+            auto count = GetUsedSlots();
+            for (std::uint32_t slot = 0; slot < count; ++slot) {
+                auto value = slots[slot].load(std::memory_order_acquire);
+                if (KeyOf(value) != 0 && StateOf(value) != 0) {
+                    a_visitor(RE::ActorHandle(KeyOf(value)), StateOf(value));
+                }
+            }
+        }
+
+        // Empties the map, returning all slots to the free pool. Each slot is swapped out
+        // atomically and handed to a_visitor if it held a non-zero state. An insert racing
+        // the drain may be dropped, as if it came just before.
+        template <class Visitor>
+        void Drain(Visitor&& a_visitor) {
+            auto count = GetUsedSlots();
+            for (std::uint32_t slot = 0; slot < count; ++slot) {
+                auto value = slots[slot].exchange(0, std::memory_order_acq_rel);
+                if (KeyOf(value) != 0) {
+                    sparse[KeyOf(value) & INDEX_MASK].store(0, std::memory_order_release);
+                    if (StateOf(value) != 0) {
+                        a_visitor(RE::ActorHandle(KeyOf(value)), StateOf(value));
+                    }
+                }
+            }
+            freeHead.store(0, std::memory_order_relaxed);
+            used.store(0, std::memory_order_release);
+        }
+
+        // High-water mark of slots handed out since the last Drain; every live slot is below this
+        [[nodiscard]] std::uint32_t GetUsedSlots() const { return used.load(std::memory_order_acquire); }
+
+        [[nodiscard]] static constexpr std::uint32_t GetCapacity() { return Capacity; }
+
+    private:
+        // The engine's handle index width; the age and active bits sit above it
+        static constexpr std::uint32_t INDEX_BITS = 20;
+        static constexpr std::uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+        static constexpr std::uint64_t Pack(std::uint32_t a_key, std::uint32_t a_state) {
+            return static_cast<std::uint64_t>(a_key) << 32 | a_state;
+        }
+
+        static constexpr std::uint32_t KeyOf(std::uint64_t a_word) { return static_cast<std::uint32_t>(a_word >> 32); }
+        static constexpr std::uint32_t StateOf(std::uint64_t a_word) { return static_cast<std::uint32_t>(a_word); }
+
+        std::optional<std::uint32_t> Find(RE::ActorHandle a_handle) const {
+            auto key = a_handle.native_handle();
+            auto entry = sparse[key & INDEX_MASK].load(std::memory_order_acquire);
+            if (entry == 0 || KeyOf(slots[entry - 1].load(std::memory_order_acquire)) != key) {
+                return std::nullopt;
+            }
+            return entry - 1u;
+        }
+
+        std::optional<std::uint32_t> FindOrInsert(RE::ActorHandle a_handle) {
+            auto key = a_handle.native_handle();
+            if (key == 0) {
+                return std::nullopt;
+            }
+
+            auto& entry = sparse[key & INDEX_MASK];
+            auto expected = entry.load(std::memory_order_acquire);
+            std::optional<std::uint32_t> claimed;
+            while (true) {
+                if (expected != 0 && KeyOf(slots[expected - 1].load(std::memory_order_acquire)) == key) {
+                    if (claimed) {
+                        // Another thread inserted the actor first; nothing links our slot yet
+                        slots[*claimed].store(0, std::memory_order_release);
+                        PushFree(*claimed);
+                    }
+                    return expected - 1u;
+                }
+
+                // Absent, or the index belongs to an older handle: give this one a fresh slot
+                // rather than take over one that a stale reader may still be updating
+                if (!claimed) {
+                    claimed = Allocate();
+                    if (!claimed) {
+                        return std::nullopt;
+                    }
+                    slots[*claimed].store(Pack(key, 0), std::memory_order_release);
+                }
+                if (entry.compare_exchange_weak(expected, static_cast<std::uint16_t>(*claimed + 1), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    if (expected != 0) {
+                        Evict(expected - 1u, key);
+                    }
+                    return claimed;
+                }
+            }
+        }
+
+        // Frees the slot an older handle with a_key's index held. Its reference is gone, and
+        // nothing can find it now; a stale update in flight sees the key vanish and looks again.
+        void Evict(std::uint32_t a_slot, std::uint32_t a_key) {
+            auto word = slots[a_slot].load(std::memory_order_acquire);
+            while (KeyOf(word) != 0 && KeyOf(word) != a_key && (KeyOf(word) & INDEX_MASK) == (a_key & INDEX_MASK)) {
+                if (slots[a_slot].compare_exchange_weak(word, 0, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    PushFree(a_slot);
+                    return;
+                }
+            }
+        }
+
+        // The free list is a Treiber stack of slot indices. Its head carries a counter in the
+        // high half, bumped by every push and pop, so a pop cannot be fooled by a slot that
+        // was taken and put back while it read the next link.
+        void PushFree(std::uint32_t a_slot) {
+            auto head = freeHead.load(std::memory_order_relaxed);
+            std::uint64_t next;
+            do {
+                nextFree[a_slot].store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+                next = ((head >> 32) + 1) << 32 | (a_slot + 1);
+            } while (!freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        std::optional<std::uint32_t> PopFree() {
+            auto head = freeHead.load(std::memory_order_acquire);
+            while (static_cast<std::uint32_t>(head) != 0) {
+                auto slot = static_cast<std::uint32_t>(head) - 1;
+                auto next = ((head >> 32) + 1) << 32 | nextFree[slot].load(std::memory_order_relaxed);
+                if (freeHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire)) {
+                    return slot;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::optional<std::uint32_t> Allocate() {
+            if (auto slot = PopFree()) {
+                return slot;
+            }
+
+            auto slot = used.load(std::memory_order_relaxed);
+            while (slot < Capacity) {
+                if (used.compare_exchange_weak(slot, slot + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    return slot;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::array<std::atomic<std::uint16_t>, 1u << INDEX_BITS> sparse{};  // Dense slot + 1; 0 when none
+        std::array<std::atomic<std::uint64_t>, Capacity> slots{};
+        std::array<std::atomic<std::uint32_t>, Capacity> nextFree{};  // Free slot below each one + 1; 0 ends the list
+        std::atomic<std::uint64_t> freeHead = 0;                         // Pop counter << 32 | top free slot + 1
+        std::atomic<std::uint32_t> used = 0;
+    };
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace SIGA {
+    // Event type enum for fast switch instead of string comparisons
+    enum class AnimEventType : std::uint8_t {
+        Unknown,
+        BowDrawn,
+        BowRelease,
+        BeginCastLeft,
+        BeginCastRight,
+        CastStop,
+        CastOKStop,
+        InterruptCast,
+        AttackStop,
+        WeaponSheathe,
+    };
+
+    inline constexpr std::size_t ANIM_EVENT_TYPE_COUNT = static_cast<std::size_t>(AnimEventType::WeaponSheathe) + 1;
+
+    namespace AnimEventTags {
+        struct Tag {
+            std::string_view name;
+            AnimEventType type;
+        };
+
+        inline constexpr std::array<Tag, 10> TAGS = { {
+            { "BowDrawn", AnimEventType::BowDrawn },
+            { "bowRelease", AnimEventType::BowRelease },
+            { "BeginCastLeft", AnimEventType::BeginCastLeft },
+            { "BeginCastRight", AnimEventType::BeginCastRight },
+            { "CastStop", AnimEventType::CastStop },
+            { "CastOKStop", AnimEventType::CastOKStop },
+            { "InterruptCast", AnimEventType::InterruptCast },
+            { "attackStop", AnimEventType::AttackStop },
+            { "WeaponSheathe", AnimEventType::WeaponSheathe },
+            { "weaponSheathe", AnimEventType::WeaponSheathe },
+        } };
+
+        // The first tag of a type, for logs and stats
+        constexpr std::string_view NameOf(AnimEventType a_type) {
+            for (auto& tag : TAGS) {
+                if (tag.type == a_type) {
+                    return tag.name;
+                }
+            }
+            return "Unknown";
+        }
+
+        namespace detail {
+            inline constexpr std::uint32_t TABLE_BITS = 4;
+            inline constexpr std::uint32_t TABLE_SIZE = 1u << TABLE_BITS;
+
+            // Bit N set when some tag is N characters long; everything else is rejected
+            // before a single character is read
+            consteval std::uint32_t MakeLengthMask() {
+                std::uint32_t mask = 0;
+                for (auto& tag : TAGS) {
+                    mask |= 1u << tag.name.size();
+                }
+                return mask;
+            }
+
+            inline constexpr std::uint32_t LENGTH_MASK = MakeLengthMask();
+
+            // Length, first and last character are enough to tell our tags apart
+            constexpr std::uint32_t Hash(const char* a_data, std::uint32_t a_length, std::uint32_t a_seed) {
+                auto key = static_cast<std::uint32_t>(static_cast<unsigned char>(a_data[0])) |
+                    static_cast<std::uint32_t>(static_cast<unsigned char>(a_data[a_length - 1])) << 8 |
+                    a_length << 16;
+                return (key * a_seed) >> (32 - TABLE_BITS);
+            }
+
+            consteval bool IsPerfect(std::uint32_t a_seed) {
+                std::array<bool, TABLE_SIZE> used{};
+                for (auto& tag : TAGS) {
+                    auto slot = Hash(tag.name.data(), static_cast<std::uint32_t>(tag.name.size()), a_seed);
+                    if (used[slot]) {
+                        return false;
+                    }
+                    used[slot] = true;
+                }
+                return true;
+            }
+
+            consteval std::uint32_t FindSeed() {
+                for (std::uint32_t seed = 0x9E3779B1u; seed != 0x9E3779B1u + 2 * 100000; seed += 2) {
+                    if (IsPerfect(seed)) {
+                        return seed;
+                    }
+                }
+                return 0;
+            }
+
+            inline constexpr std::uint32_t SEED = FindSeed();
+            static_assert(SEED != 0, "No collision-free seed for the animation tag table; raise TABLE_BITS");
+
+            struct Slot {
+                const char* name = nullptr;
+                std::uint32_t length = 0;
+                AnimEventType type = AnimEventType::Unknown;
+            };
+
+            consteval std::array<Slot, TABLE_SIZE> MakeTable() {
+                std::array<Slot, TABLE_SIZE> table{};
+                for (auto& tag : TAGS) {
+                    auto length = static_cast<std::uint32_t>(tag.name.size());
+                    table[Hash(tag.name.data(), length, SEED)] = { tag.name.data(), length, tag.type };
+                }
+                return table;
+            }
+
+            inline constexpr std::array<Slot, TABLE_SIZE> TABLE = MakeTable();
+        }
+
+        // Perfect-hash lookup: length filter, one table probe, one compare on a hit.
+        // Takes the length explicitly so BSFixedString's cached size avoids a strlen.
+        [[nodiscard]] constexpr AnimEventType Classify(const char* a_data, std::uint32_t a_length) {
+            if (a_length >= 32 || !((detail::LENGTH_MASK >> a_length) & 1u)) {
+                return AnimEventType::Unknown;
+            }
+
+            auto& slot = detail::TABLE[detail::Hash(a_data, a_length, detail::SEED)];
+            if (slot.length != a_length || std::string_view(slot.name, a_length) != std::string_view(a_data, a_length)) {
+                return AnimEventType::Unknown;
+            }
+            return slot.type;
+        }
+
+        [[nodiscard]] constexpr AnimEventType Classify(std::string_view a_tag) {
+            return Classify(a_tag.data(), static_cast<std::uint32_t>(a_tag.size()));
+        }
+
+        static_assert([] {
+            for (auto& tag : TAGS) {
+                if (Classify(tag.name) != tag.type) {
+                    return false;
+                }
+            }
+            return Classify("FootLeft") == AnimEventType::Unknown &&
+                Classify("bowDrawn") == AnimEventType::Unknown &&
+                Classify("") == AnimEventType::Unknown;
+        }());
+    }
+}
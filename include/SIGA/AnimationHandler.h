@@ -1,4 +1,10 @@
 #pragma once
+#include "SIGA/AnimEventTags.h"
+#include "SIGA/Config.h"
+#include "SIGA/MpscQueue.h"
+#include "SIGA/SpellIndex.h"
+
+#include <atomic>
 
 namespace SIGA {
     class AnimationEventHandler : public RE::BSTEventSink<RE::BSAnimationGraphEvent> {
@@ -6,22 +12,47 @@ namespace SIGA {
         static AnimationEventHandler* GetSingleton();
 
 
+        // Runs on the engine's animation threads. Only classifies the event: a relevant one
+        // is queued for the main thread, everything else returns here.
         RE::BSEventNotifyControl ProcessEvent(
             const RE::BSAnimationGraphEvent* a_event,
             RE::BSTEventSource<RE::BSAnimationGraphEvent>* a_eventSource) override;
 
+        // Handles every queued event in arrival order with one config snapshot, then
+        // flushes the slowdowns they changed. Scheduled as an SKSE task by the first event
+        // queued after the last drain; main thread only.
+        void DrainEvents();
+
+        // Drops queued events without handling them; call when a save loads. Main thread only.
+        void DiscardQueued();
+
     private:
         AnimationEventHandler() = default;
         AnimationEventHandler(const AnimationEventHandler&) = delete;
         AnimationEventHandler(AnimationEventHandler&&) = delete;
 
-        void OnBowDrawn(RE::Actor* actor);
-        void OnBeginCastLeft(RE::Actor* actor);
-        void OnBeginCastRight(RE::Actor* actor);
+        struct QueuedEvent {
+            RE::ActorHandle handle;
+            AnimEventType type;
+            std::uint64_t ticks;  // ReadTicks() when queued
+        };
+
+        // A frame sees a few dozen relevant events even in a large battle
+        static constexpr std::uint32_t EVENT_QUEUE_CAPACITY = 4096;
+
+        void ScheduleDrain();
+        void HandleEvent(RE::Actor* actor, AnimEventType eventType, const Config::Snapshot* config);
+
+        void OnBowDrawn(RE::Actor* actor, const Config::Snapshot* config);
+        void OnBeginCastLeft(RE::Actor* actor, const Config::Snapshot* config);
+        void OnBeginCastRight(RE::Actor* actor, const Config::Snapshot* config);
         void OnCastRelease(RE::Actor* actor);
         void OnAttackStop(RE::Actor* actor);
 
-        float GetMagicSkillLevel(RE::Actor* actor, RE::MagicItem* spell);
-        bool SpellModifiesSpeed(RE::MagicItem* spell);  // <-- ADD THIS
+        float GetMagicSkillLevel(RE::Actor* actor, const std::optional<SpellIndex::Info>& spellInfo);
+
+        MpscQueue<QueuedEvent, EVENT_QUEUE_CAPACITY> eventQueue;
+        std::atomic<bool> drainScheduled = false;
+        std::atomic<std::uint64_t> droppedEvents = 0;  // Since the last drain logged them
     };
 }
\ No newline at end of file
@@ -1,9 +1,15 @@
 #pragma once
+#include "SIGA/ActorEligibility.h"
 #include <unordered_set>  
 #include <mutex>          
 
 namespace SIGA {
-    class CombatEventHandler : public RE::BSTEventSink<RE::TESCombatEvent> {
+    // Adds the animation sink to NPCs entering combat and takes it off again when they
+    // leave combat, die or unload, so only active combatants reach AnimationEventHandler
+    class CombatEventHandler :
+        public RE::BSTEventSink<RE::TESCombatEvent>,
+        public RE::BSTEventSink<RE::TESDeathEvent>,
+        public RE::BSTEventSink<RE::TESCellAttachDetachEvent> {
     public:
         static CombatEventHandler* GetSingleton() {
             static CombatEventHandler singleton;
@@ -14,13 +20,39 @@ namespace SIGA {
             const RE::TESCombatEvent* a_event,
             RE::BSTEventSource<RE::TESCombatEvent>* a_eventSource) override;
 
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::TESDeathEvent* a_event,
+            RE::BSTEventSource<RE::TESDeathEvent>* a_eventSource) override;
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::TESCellAttachDetachEvent* a_event,
+            RE::BSTEventSource<RE::TESCellAttachDetachEvent>* a_eventSource) override;
+
+        // NPCs whose animation events currently reach AnimationEventHandler
+        [[nodiscard]] std::size_t GetRegisteredCount();
+
+        // Forgets every registration; call on a game load, whose actors get new graphs and
+        // register again on their next combat event
+        void Clear();
+
+        // False if the NPC is certainly not a registered combatant; lock-free, for ProcessEvent
+        [[nodiscard]] bool IsEligible(RE::FormID a_formID) const noexcept { return eligibility.Test(a_formID); }
+
     private:
         CombatEventHandler() = default;
         CombatEventHandler(const CombatEventHandler&) = delete;
         CombatEventHandler(CombatEventHandler&&) = delete;
         ~CombatEventHandler() = default;
 
+        // Removes the sink and any slowdown left on the actor; a no-op if it has no sink
+        void Unregister(RE::TESObjectREFR* a_reference, const char* a_reason);
+
+        // NPCs with our sink, or with one being added. Held only around set and bit
+        // updates; the engine calls that register and unregister run outside it.
         std::unordered_set<RE::FormID> registeredNPCs;
         std::mutex registrationMutex;
+
+        // Mirrors registeredNPCs, rebuilt under registrationMutex
+        ActorEligibility eligibility;
     };
 }
\ No newline at end of file
@@ -1,50 +1,105 @@
 #pragma once
+#include "SIGA/MagnitudeCurve.h"
+#include "SIGA/TraceLog.h"
 #include <array>
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace SIGA {
     class Config {
     public:
+        // How a slowdown is applied to an actor
+        enum class SlowdownBackend {
+            kSpell = 0,      // Cast the debuff spells from the plugin
+            kSpeedMult = 1,  // Temporary SpeedMult modifier, no magic effect
+        };
+
+        // One complete, frozen set of settings. Readers take the current one with a single
+        // acquire load and never see a half-updated config; a reload publishes a new one.
+        struct alignas(64) Snapshot {
+            // General settings
+            bool enabled = true;
+            bool applyToNPCs = false;
+            bool applySlowdownCastingToNPCsOnly = false;  // If true, casting slowdown applies to NPCs only, not player
+            int logLevel = 2;  // 0=trace, 1=debug, 2=info, 3=warn, 4=error, 5=critical
+            SlowdownBackend slowdownBackend = SlowdownBackend::kSpell;
+            bool binaryTrace = false;  // Record events to a trace file, in traceFormat
+            TraceLog::OutputFormat traceFormat = TraceLog::OutputFormat::kBinary;  // Read at startup only
+            bool metrics = false;      // Count events and time slowdowns into SigaNG.stats
+            float stuckSlowdownTimeout = 120.0f;  // Seconds without animation events before a slowdown is cleared; 0 = never
+
+            // Enable/Disable specific debuffs
+            bool enableBowDebuff = true;
+            bool enableCrossbowDebuff = true;
+            bool enableCastDebuff = true;
+            bool enableDualCastDebuff = true;
+
+            // Bow multipliers (Novice/Apprentice/Expert/Master)
+            std::array<float, 4> bowMultipliers = { 0.5f, 0.6f, 0.7f, 0.8f };
+            std::array<float, 4> crossbowMultipliers = { 0.5f, 0.6f, 0.7f, 0.8f };
+            std::array<float, 4> castMultipliers = { 0.5f, 0.6f, 0.7f, 0.8f };
+            std::array<float, 4> dualCastMultipliers = { 0.4f, 0.5f, 0.6f, 0.7f };
+
+            // Skill curves; the default shape uses the tier multipliers above
+            MagnitudeCurve bowCurve;
+            MagnitudeCurve crossbowCurve;
+            MagnitudeCurve castCurve;
+            MagnitudeCurve dualCastCurve;
+
+            // Plugin configuration
+            std::string pluginName = "SigaNG.esp";
+
+            // Spell Form IDs (hex values - last 12 bits for ESL plugins)
+            RE::FormID bowDebuffSpellID = 0x801;
+            RE::FormID castingDebuffSpellID = 0x805;
+            RE::FormID dualCastDebuffSpellID = 0x806;
+            RE::FormID crossbowDebuffSpellID = 0x807;
+
+            // Compiled from the curves by Publish
+            MagnitudeTable bowTable{};
+            MagnitudeTable crossbowTable{};
+            MagnitudeTable castTable{};
+            MagnitudeTable dualCastTable{};
+        };
+
         static Config* GetSingleton() {
             static Config singleton;
             return &singleton;
         }
 
         void Load();
-        void Save();
-
-        // General settings
-        bool enabled = true;
-        bool applyToNPCs = false;
-        bool applySlowdownCastingToNPCsOnly = false;  // If true, casting slowdown applies to NPCs only, not player
-        int logLevel = 2;  // 0=trace, 1=debug, 2=info, 3=warn, 4=error, 5=critical
-
-        // Enable/Disable specific debuffs
-        bool enableBowDebuff = true;
-        bool enableCrossbowDebuff = true;
-        bool enableCastDebuff = true;
-        bool enableDualCastDebuff = true;
-
-        // Bow multipliers (Novice/Apprentice/Expert/Master)
-        std::array<float, 4> bowMultipliers = { 0.5f, 0.6f, 0.7f, 0.8f };
-        std::array<float, 4> crossbowMultipliers = { 0.5f, 0.6f, 0.7f, 0.8f };
-        std::array<float, 4> castMultipliers = { 0.5f, 0.6f, 0.7f, 0.8f };
-        std::array<float, 4> dualCastMultipliers = { 0.4f, 0.5f, 0.6f, 0.7f };
-
-        // Plugin configuration
-        std::string pluginName = "SigaNG.esp";
-
-        // Spell Form IDs (hex values - last 12 bits for ESL plugins)
-        RE::FormID bowDebuffSpellID = 0x801;
-        RE::FormID castingDebuffSpellID = 0x805;
-        RE::FormID dualCastDebuffSpellID = 0x806;
-        RE::FormID crossbowDebuffSpellID = 0x807;
+        void Save() const;
+
+        // The current settings. Hold the pointer for the whole event so every check sees
+        // the same config; published snapshots stay valid until the game exits.
+        [[nodiscard]] const Snapshot* GetSnapshot() const { return current.load(std::memory_order_acquire); }
+
+        // Compiles a_snapshot's magnitude tables, freezes it and makes it current
+        const Snapshot* Publish(Snapshot a_snapshot);
+
+        // Settings from SIGA.ini text, with out-of-range values clamped and missing keys at
+        // their defaults. Empty if the text is not an ini, or with a_rejectPartial if it has
+        // no General.bEnabled, as a file read while an editor is still writing it may not.
+        [[nodiscard]] static std::optional<Snapshot> Parse(const std::string& a_text, bool a_rejectPartial = false);
+
+        [[nodiscard]] static std::optional<std::string> ReadFile(const std::filesystem::path& a_path);
+        [[nodiscard]] static std::filesystem::path GetConfigPath();
 
     private:
-        Config() = default;
+        Config();
         Config(const Config&) = delete;
         Config(Config&&) = delete;
 
-        static std::filesystem::path GetConfigPath();
+        std::atomic<const Snapshot*> current = nullptr;
+
+        // Readers never announce when they are done, so retired snapshots are kept rather
+        // than freed; there is one per reload, and reloads are rare
+        std::mutex publishLock;
+        std::vector<std::unique_ptr<const Snapshot>> published;
     };
-}
\ No newline at end of file
+}
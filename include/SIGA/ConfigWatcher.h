@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+
+namespace SIGA {
+    // Reloads SIGA.ini while the game runs. A background thread polls the file's timestamp
+    // and size; once a change has settled it reads, hashes and parses the file off the main
+    // thread, publishes the new snapshot, and hands the live slowdowns to the main thread.
+    class ConfigWatcher {
+    public:
+        static ConfigWatcher* GetSingleton() {
+            static ConfigWatcher singleton;
+            return &singleton;
+        }
+
+        // Takes the file as it is now as already loaded. Restarts if already watching. With
+        // a zero interval no thread is started and the caller runs Poll itself.
+        void Start(std::filesystem::path a_path, std::chrono::milliseconds a_interval = std::chrono::milliseconds(1000));
+        void Stop();
+
+        // One check of the file, as the thread runs it. True if a new config was published.
+        bool Poll();
+
+        std::uint64_t GetReloadCount() const { return reloadCount.load(std::memory_order_relaxed); }
+
+    private:
+        ConfigWatcher() = default;
+        ConfigWatcher(const ConfigWatcher&) = delete;
+        ConfigWatcher(ConfigWatcher&&) = delete;
+        ~ConfigWatcher() { Stop(); }
+
+        struct FileStamp {
+            std::filesystem::file_time_type writeTime{};
+            std::uintmax_t size = 0;
+
+            bool operator==(const FileStamp&) const = default;
+        };
+
+        static std::optional<FileStamp> StampOf(const std::filesystem::path& a_path);
+        static std::uint64_t HashOf(const std::string& a_text);
+
+        void Run(std::stop_token a_stop);
+
+        std::filesystem::path path;
+        std::chrono::milliseconds interval{ 1000 };
+
+        // Poll state; the watcher thread's own, or the caller's when not started
+        std::optional<FileStamp> loadedStamp;   // The file as last read
+        std::optional<FileStamp> changedStamp;  // Seen once; read when the next poll agrees
+        std::uint64_t loadedHash = 0;
+
+        std::atomic<std::uint64_t> reloadCount = 0;
+
+        std::mutex wakeMutex;
+        std::condition_variable_any wake;
+        std::jthread thread;
+    };
+}
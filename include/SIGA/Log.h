@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+// Trace and debug logging goes through these macros. Below SPDLOG_ACTIVE_LEVEL (see
+// SIGA_STRIP_DEBUG_LOGS in CMakeLists.txt) a call compiles to nothing, arguments and all.
+// Otherwise the arguments are only evaluated when the level is enabled at runtime, so a
+// call like SIGA_LOG_DEBUG("{}", actor->GetName()) costs one level check when debug is off.
+#define SIGA_LOG_CALL(a_level, a_function, ...)      \
+    do {                                             \
+        if (spdlog::should_log(a_level)) {           \
+            SKSE::log::a_function(__VA_ARGS__);      \
+        }                                            \
+    } while (0)
+
+// A stripped call still names its arguments, unevaluated, so a local that only feeds a
+// log line does not warn as unused in Release
+#define SIGA_LOG_DISCARD(...) (void)sizeof(::SIGA::Log::Discard(__VA_ARGS__))
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#    define SIGA_LOG_TRACE(...) SIGA_LOG_CALL(spdlog::level::trace, trace, __VA_ARGS__)
+#else
+#    define SIGA_LOG_TRACE(...) SIGA_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#    define SIGA_LOG_DEBUG(...) SIGA_LOG_CALL(spdlog::level::debug, debug, __VA_ARGS__)
+#else
+#    define SIGA_LOG_DEBUG(...) SIGA_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+namespace SIGA::Log {
+    // Only ever named inside sizeof by SIGA_LOG_DISCARD; never called
+    template <class... Args>
+    constexpr int Discard(const Args&...) noexcept { return 0; }
+
+    inline constexpr std::size_t QUEUE_SIZE = 8192;  // Messages; the oldest are dropped when full
+
+    // A logger whose callers only format and enqueue; one background thread writes to
+    // a_sink. Game threads never wait on the file, even when the queue is full.
+    [[nodiscard]] std::shared_ptr<spdlog::logger> MakeAsyncLogger(std::string a_name, spdlog::sink_ptr a_sink);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SIGA {
+    // Slowdown magnitude and tier for one whole skill level; fits one lock-free atomic word
+    struct MagnitudeEntry {
+        float magnitude = 0.0f;
+        std::uint32_t tier = 0;
+    };
+
+    inline constexpr std::uint32_t MAX_TABLE_SKILL = 100;  // Higher skills use the last entry
+
+    // A curve compiled for every whole skill level, so a lookup is one indexed load
+    using MagnitudeTable = std::array<MagnitudeEntry, MAX_TABLE_SKILL + 1>;
+
+    // Maps skill level to a speed multiplier for one slowdown type. The default keeps
+    // the four fixed tiers; SIGA.ini may instead give points to interpolate between.
+    struct MagnitudeCurve {
+        enum class Shape {
+            kTiers,   // Step function over the four tier multipliers
+            kLinear,  // Piecewise-linear through the points
+            kSmooth,  // Monotone cubic through the points: no overshoot between them
+        };
+
+        struct Point {
+            float skill = 0.0f;
+            float multiplier = 1.0f;
+        };
+
+        Shape shape = Shape::kTiers;
+        std::vector<Point> points;  // Sorted by skill, unique skills
+
+        // Novice/Apprentice/Expert/Master, by skill: up to 25, 50, 75, above
+        [[nodiscard]] static std::uint32_t TierFor(float a_skill);
+
+        // a_tierMultipliers is used for kTiers, and when there are no points to interpolate
+        [[nodiscard]] float Evaluate(float a_skill, const std::array<float, 4>& a_tierMultipliers) const;
+        [[nodiscard]] MagnitudeTable Compile(const std::array<float, 4>& a_tierMultipliers) const;
+
+        // Table index for a skill. Rounds up, so a fractional skill lands in the same tier
+        // as TierFor puts it.
+        [[nodiscard]] static std::uint32_t SkillIndex(float a_skill);
+
+        // multiplier 0.5 = 50% speed = need to REDUCE by 50 = magnitude 50
+        [[nodiscard]] static float MagnitudeFromMultiplier(float a_multiplier) { return 100.0f - (a_multiplier * 100.0f); }
+
+        // The tiers as points at each tier's upper skill bound: a sensible start for a custom curve
+        [[nodiscard]] static std::vector<Point> PointsFromTiers(const std::array<float, 4>& a_tierMultipliers);
+
+        // "skill:multiplier, skill:multiplier, ..." as written in SIGA.ini
+        [[nodiscard]] static std::optional<std::vector<Point>> ParsePoints(std::string_view a_text);
+        [[nodiscard]] static std::string FormatPoints(const std::vector<Point>& a_points);
+
+        [[nodiscard]] static std::optional<Shape> ParseShape(std::string_view a_text);
+        [[nodiscard]] static const char* ShapeName(Shape a_shape);
+    };
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "SIGA/AnimEventTags.h"
+#include "SIGA/Ticks.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SIGA {
+    // Hot-path counters and latency histograms. Each thread writes only its own cache-line
+    // aligned block, without atomic read-modify-writes; a background thread sums the blocks
+    // and rewrites the stats file every DUMP_INTERVAL. Disabled, every site costs one branch.
+    class Metrics {
+    public:
+        enum class Counter : std::uint32_t {
+            kProcessEvent,
+            // ProcessEvent's rejection stages, cheapest and most common first
+            kRejectNoActor,       // No event, holder, or the holder is not an actor or is gone by the drain
+            kRejectUnknownTag,    // Not one of our animation tags
+            kRejectNotEligible,   // NPC's eligibility bit is clear: not a registered combatant
+            kRejectQueueFull,     // Event queue full; the event is dropped
+            // The rest are checked when the main thread drains the queue
+            kRejectNPCsDisabled,  // bApplyToNPCs is off
+            kRejectNotInCombat,   // NPC out of combat, behind a shared eligibility bit
+            kCastSpell,
+            kDispelSpell,
+            kModifySpeedMult,
+
+            kTotal
+        };
+
+        enum class Histogram : std::uint32_t {
+            kApplySlowdown,
+            kRemoveSlowdown,
+            kEventQueueDelay,  // From ProcessEvent queueing an event to the main thread handling it
+
+            kTotal
+        };
+
+        // Mutexes whose wait and hold times are recorded
+        enum class Lock : std::uint32_t {
+            kRegistration,   // CombatEventHandler's registered NPC set
+            kPendingActors,  // SlowMotionManager's pending-actor shards
+            kTimerWheel,     // SlowdownTimers' wheel buckets
+
+            kTotal
+        };
+
+        static constexpr std::uint32_t HISTOGRAM_BUCKETS = 40;  // Bucket b: latencies in [2^(b-1), 2^b) ticks
+
+        static Metrics* GetSingleton() {
+            static Metrics singleton;
+            return &singleton;
+        }
+
+        // Where the stats go; rewritten every DUMP_INTERVAL while enabled
+        void SetOutput(std::filesystem::path a_path);
+        void SetEnabled(bool a_enabled);
+        [[nodiscard]] bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+        void Count(Counter a_counter) {
+            if (IsEnabled()) {
+                Bump(Local().counters[static_cast<std::size_t>(a_counter)]);
+            }
+        }
+
+        void CountEvent(AnimEventType a_type) {
+            if (IsEnabled()) {
+                Bump(Local().events[static_cast<std::size_t>(a_type)]);
+            }
+        }
+
+        // Times its scope into a histogram; reads no clock while metrics are disabled
+        class ScopedTimer {
+        public:
+            explicit ScopedTimer(Histogram a_histogram) :
+                histogram(a_histogram), start(GetSingleton()->IsEnabled() ? ReadTicks() : 0) {}
+            ~ScopedTimer() {
+                if (start) {
+                    GetSingleton()->Record(histogram, ReadTicks() - start);
+                }
+            }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        private:
+            Histogram histogram;
+            std::uint64_t start;
+        };
+
+        // lock_guard that also records how long the caller waited for the mutex and how
+        // long it held it. An acquire that succeeds on try_lock records no wait, so the
+        // stats tell contended acquires apart. Reads no clock while metrics are disabled.
+        template <class Mutex>
+        class TimedLock {
+        public:
+            TimedLock(Mutex& a_mutex, Lock a_lock) :
+                mutex(a_mutex), lock(a_lock) {
+                if (!GetSingleton()->IsEnabled()) {
+                    mutex.lock();
+                    return;
+                }
+                std::uint64_t wait = 0;
+                if (!mutex.try_lock()) {
+                    auto start = ReadTicks();
+                    mutex.lock();
+                    acquired = ReadTicks();
+                    wait = std::max<std::uint64_t>(acquired - start, 1);
+                }
+                else {
+                    acquired = ReadTicks();
+                }
+                GetSingleton()->RecordWait(lock, wait);
+            }
+            ~TimedLock() {
+                if (acquired) {
+                    GetSingleton()->RecordHold(lock, ReadTicks() - acquired);
+                }
+                mutex.unlock();
+            }
+
+            TimedLock(const TimedLock&) = delete;
+            TimedLock& operator=(const TimedLock&) = delete;
+
+        private:
+            Mutex& mutex;
+            Lock lock;
+            std::uint64_t acquired = 0;
+        };
+
+        // Records the time since a_startTicks, read on this thread or another
+        void RecordSince(Histogram a_histogram, std::uint64_t a_startTicks) {
+            if (IsEnabled()) {
+                Record(a_histogram, ReadTicks() - a_startTicks);
+            }
+        }
+
+        // Totals over every thread since metrics were enabled
+        struct Snapshot {
+            std::array<std::uint64_t, static_cast<std::size_t>(Counter::kTotal)> counters{};
+            std::array<std::uint64_t, ANIM_EVENT_TYPE_COUNT> events{};
+            std::array<std::array<std::uint64_t, HISTOGRAM_BUCKETS>, static_cast<std::size_t>(Histogram::kTotal)> histograms{};
+            // Bucket 0 of a wait histogram counts the uncontended acquires
+            std::array<std::array<std::uint64_t, HISTOGRAM_BUCKETS>, static_cast<std::size_t>(Lock::kTotal)> lockWaits{};
+            std::array<std::array<std::uint64_t, HISTOGRAM_BUCKETS>, static_cast<std::size_t>(Lock::kTotal)> lockHolds{};
+            double nsPerTick = 1.0;
+        };
+
+        [[nodiscard]] Snapshot Collect() const;
+
+        // Writes the stats file now; the dump thread does this every DUMP_INTERVAL
+        void Dump() const;
+
+        // Zeroes every thread's counters. Only safe while nothing is recording.
+        void Reset();
+
+        static const char* CounterName(Counter a_counter);
+        static const char* HistogramName(Histogram a_histogram);
+        static const char* LockName(Lock a_lock);
+
+        // Upper bound, in ticks, of the bucket holding a_percentile of the samples
+        static std::uint64_t Percentile(const std::array<std::uint64_t, HISTOGRAM_BUCKETS>& a_buckets, double a_percentile);
+
+    private:
+        Metrics() = default;
+        Metrics(const Metrics&) = delete;
+        Metrics(Metrics&&) = delete;
+        ~Metrics();
+
+        static constexpr auto DUMP_INTERVAL = std::chrono::seconds(10);
+
+        // One per thread, on its own cache lines. Only the owner writes; relaxed atomics
+        // let the dump thread read without tearing.
+        struct alignas(64) ThreadMetrics {
+            std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::kTotal)> counters{};
+            std::array<std::atomic<std::uint64_t>, ANIM_EVENT_TYPE_COUNT> events{};
+            std::array<std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS>, static_cast<std::size_t>(Histogram::kTotal)> histograms{};
+            std::array<std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS>, static_cast<std::size_t>(Lock::kTotal)> lockWaits{};
+            std::array<std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS>, static_cast<std::size_t>(Lock::kTotal)> lockHolds{};
+        };
+
+        // Single writer: a load and a store, no locked add
+        static void Bump(std::atomic<std::uint64_t>& a_value) {
+            a_value.store(a_value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        ThreadMetrics& Local();
+        ThreadMetrics& RegisterThread();
+        static std::uint32_t BucketOf(std::uint64_t a_ticks);
+        void Record(Histogram a_histogram, std::uint64_t a_ticks);
+        void RecordWait(Lock a_lock, std::uint64_t a_ticks);
+        void RecordHold(Lock a_lock, std::uint64_t a_ticks);
+        void Run(std::stop_token a_stop);
+
+        std::atomic<bool> enabled = false;
+
+        // Blocks are never freed: a thread may still hold its pointer
+        mutable std::mutex threadsMutex;
+        std::vector<std::unique_ptr<ThreadMetrics>> threads;
+
+        // Tick rate, measured between enabling and each collection
+        std::uint64_t startTicks = 0;
+        std::chrono::steady_clock::time_point startTime;
+
+        mutable std::mutex outputMutex;
+        std::filesystem::path path;
+
+        std::mutex wakeMutex;
+        std::condition_variable_any wake;
+        std::jthread dumper;
+    };
+}
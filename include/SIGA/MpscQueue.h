@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SIGA {
+    // Bounded lock-free ring for many producers and one consumer. Each cell carries a
+    // sequence number saying whose turn it is: a producer claims a position with one CAS
+    // on the tail, writes the value and publishes it through the cell's sequence, so the
+    // consumer never sees a half-written entry. The consumer owns the head outright and
+    // hands each cell back one lap ahead. A full ring refuses the push instead of waiting.
+    template <class T, std::uint32_t Capacity>
+    class MpscQueue {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        MpscQueue() {
+            for (std::uint32_t i = 0; i < Capacity; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread. False if the ring is full.
+        bool TryPush(const T& a_value) {
+            auto position = tail.load(std::memory_order_relaxed);
+            while (true) {
+                auto& cell = cells[position & MASK];
+                auto sequence = cell.sequence.load(std::memory_order_acquire);
+                auto lag = static_cast<std::int64_t>(sequence - position);
+                if (lag == 0) {
+                    if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        cell.value = a_value;
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lag < 0) {
+                    // The consumer has not freed this cell since the last lap
+                    return false;
+                }
+                else {
+                    position = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Consumer only. Hands every published entry to a_visitor in push order, at most
+        // one lap's worth, so producers cannot keep it going forever. Returns the count.
+        template <class Visitor>
+        std::size_t Drain(Visitor&& a_visitor) {
+            std::size_t count = 0;
+            while (count < Capacity) {
+                auto& cell = cells[head & MASK];
+                if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+                    // Empty, or the next producer is still writing; it is picked up next time
+                    break;
+                }
+                T value = cell.value;
+                cell.sequence.store(head + Capacity, std::memory_order_release);
+                ++head;
+                ++count;
+                a_visitor(value);
+            }
+            return count;
+        }
+
+        [[nodiscard]] static constexpr std::uint32_t GetCapacity() { return Capacity; }
+
+    private:
+        static constexpr std::uint64_t MASK = Capacity - 1;
+
+        struct Cell {
+            std::atomic<std::uint64_t> sequence;
+            T value;
+        };
+
+        // Producers and the consumer each on their own line
+        alignas(64) std::atomic<std::uint64_t> tail = 0;
+        alignas(64) std::uint64_t head = 0;
+        alignas(64) std::array<Cell, Capacity> cells;
+    };
+}
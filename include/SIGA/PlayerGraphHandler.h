@@ -0,0 +1,38 @@
+#pragma once
+
+namespace SIGA {
+    // Keeps AnimationEventHandler attached to the player's animation graph. The graph is
+    // rebuilt, dropping its sinks, whenever the player's 3D loads or their race changes
+    // (werewolf and vampire lord transforms included), so both events re-attach it.
+    class PlayerGraphHandler :
+        public RE::BSTEventSink<RE::TESObjectLoadedEvent>,
+        public RE::BSTEventSink<RE::TESSwitchRaceCompleteEvent> {
+    public:
+        static PlayerGraphHandler* GetSingleton() {
+            static PlayerGraphHandler singleton;
+            return &singleton;
+        }
+
+        // Attaches the sink to the player's current graph. False if the player has no graph
+        // yet; the 3D load that follows attaches it then.
+        bool Register();
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::TESObjectLoadedEvent* a_event,
+            RE::BSTEventSource<RE::TESObjectLoadedEvent>* a_eventSource) override;
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::TESSwitchRaceCompleteEvent* a_event,
+            RE::BSTEventSource<RE::TESSwitchRaceCompleteEvent>* a_eventSource) override;
+
+    private:
+        PlayerGraphHandler() = default;
+        PlayerGraphHandler(const PlayerGraphHandler&) = delete;
+        PlayerGraphHandler(PlayerGraphHandler&&) = delete;
+        ~PlayerGraphHandler() = default;
+
+        // A rebuilt graph lost the release event of anything in progress, so the player's
+        // slowdowns are cleared along with re-attaching
+        void OnGraphRebuilt(const char* a_reason);
+    };
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "SIGA/ActorSlotMap.h"
+
+namespace SIGA {
+    // The skills slowdown magnitudes depend on, per actor, so casts and draws read a table
+    // instead of the actor value system. Columns are stored per skill (SoA) and indexed by
+    // the actor's slot. A row goes stale on a skill or level increase, on an equip (fortify
+    // gear and potions) and when the actor enters combat; the next read refreshes it. Rows
+    // are keyed by handle and freed when the actor's sink comes off, or all at once at a
+    // load. Reads, Forget and Clear all run on the main thread, so a freed row is never
+    // refilled under a read.
+    class SkillCache :
+        public RE::BSTEventSink<RE::SkillIncrease::Event>,
+        public RE::BSTEventSink<RE::LevelIncrease::Event>,
+        public RE::BSTEventSink<RE::TESEquipEvent> {
+    public:
+        static SkillCache* GetSingleton() {
+            static SkillCache singleton;
+            return &singleton;
+        }
+
+        // Archery or one magic school; any other skill is read from the actor directly
+        [[nodiscard]] float GetSkill(RE::Actor* a_actor, RE::ActorValue a_skill);
+
+        // The five magic schools averaged, for spells with no school of their own
+        [[nodiscard]] float GetMagicAverage(RE::Actor* a_actor);
+
+        // Marks one actor's skills stale
+        void Invalidate(RE::ActorHandle a_handle);
+
+        // Stops tracking the actor and frees its row
+        void Forget(RE::ActorHandle a_handle);
+
+        // Marks every actor's skills stale, as a level-up does
+        void InvalidateAll();
+
+        // Drops every row; call when a save loads, as the old game's actors never unregister
+        void Clear();
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::SkillIncrease::Event* a_event,
+            RE::BSTEventSource<RE::SkillIncrease::Event>* a_eventSource) override;
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::LevelIncrease::Event* a_event,
+            RE::BSTEventSource<RE::LevelIncrease::Event>* a_eventSource) override;
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::TESEquipEvent* a_event,
+            RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource) override;
+
+        // Reads that went to the actor value system
+        [[nodiscard]] std::uint64_t GetRefreshCount() const;
+        void ResetRefreshCount();
+
+    private:
+        SkillCache() = default;
+        SkillCache(const SkillCache&) = delete;
+        SkillCache(SkillCache&&) = delete;
+        ~SkillCache() = default;
+
+        enum Column : std::uint32_t {
+            kArchery,
+            kDestruction,
+            kRestoration,
+            kAlteration,
+            kConjuration,
+            kIllusion,
+            kMagicAverage,
+
+            kColumnCount
+        };
+
+        static constexpr std::uint32_t MAX_TRACKED_ACTORS = 1024;
+
+        static std::optional<Column> ColumnOf(RE::ActorValue a_skill);
+
+        // Reads one column, refreshing the actor's row from the engine if it is stale
+        float Read(RE::Actor* a_actor, Column a_column);
+
+        // A row is current while its table word equals the epoch's; a level-up bumps the
+        // epoch and so invalidates every row at once
+        [[nodiscard]] std::uint32_t CurrentWord() const { return epoch.load(std::memory_order_relaxed) << 1 | 1; }
+
+        ActorSlotMap<MAX_TRACKED_ACTORS> rows;
+        std::array<std::array<std::atomic<float>, MAX_TRACKED_ACTORS>, kColumnCount> columns{};
+
+        std::atomic<std::uint32_t> epoch = 1;
+        std::atomic<std::uint64_t> refreshes = 0;
+    };
+}
@@ -1,7 +1,11 @@
 #pragma once
 
-#include <unordered_map>
+#include "SIGA/ActorSlotMap.h"
+#include "SIGA/Config.h"
+#include <array>
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace SIGA {
     enum class SlowType {
@@ -9,37 +13,145 @@ namespace SIGA {
         Crossbow,
         CastLeft,
         CastRight,
-        DualCast
+        DualCast,
+
+        Total
     };
 
     class SlowMotionManager {
     public:
         static SlowMotionManager* GetSingleton();
 
-        // Initialize spell lookups
+        // Initialize spell lookups and build the per-tier spell variants. Call at kDataLoaded.
         bool Initialize();
 
-        void ApplySlowdown(RE::Actor* actor, SlowType type, float skillLevel);
+        // a_config is the caller's snapshot, so one event sees one config; null reads the current one
+        void ApplySlowdown(RE::Actor* actor, SlowType type, float skillLevel, const Config::Snapshot* a_config = nullptr);
         void RemoveSlowdown(RE::Actor* actor, SlowType type);
         void ClearAllSlowdowns(RE::Actor* actor);
+        // Safe from any thread; true if the actor had a slowdown to clear
+        bool ClearAllSlowdowns(RE::ActorHandle handle);
         void ClearAll();
 
+        // Drops every slowdown without an engine call: after a load, the ledger's handles
+        // name the new game's actors, which never had our effects. Main thread only.
+        void ForgetAll();
+
         bool IsActorSlowed(RE::Actor* actor);
 
+        // Switching backends first removes every slowdown through the old one. Main thread only.
+        void SetBackend(Config::SlowdownBackend a_backend);
+        Config::SlowdownBackend GetBackend() const { return backend; }
+
+        // Apply/Remove only record the desired effects; this issues the engine calls for
+        // whatever changed since the last flush. Runs once per frame on the main thread.
+        void Flush();
+
+        // Brings live slowdowns in line with a reloaded config: switches backend, re-stamps the
+        // tier spells' magnitudes, and drops every slowdown of a type that is now disabled.
+        // Main thread only.
+        void ApplyConfigChange(const Config::Snapshot& a_previous, const Config::Snapshot& a_current);
+
+        struct CoalescingStats {
+            std::uint64_t flushes = 0;
+            std::uint64_t castCalls = 0;     // CastSpellImmediate actually issued
+            std::uint64_t dispelCalls = 0;   // DispelEffect actually issued
+            std::uint64_t modifierCalls = 0; // SpeedMult modifier changes actually issued
+            std::uint64_t savedCalls = 0;    // Calls applying each request immediately would have added
+        };
+
+        CoalescingStats GetCoalescingStats() const;
+        void ResetCoalescingStats();
+        void LogCoalescingStats() const;
+
     private:
         SlowMotionManager() = default;
         SlowMotionManager(const SlowMotionManager&) = delete;
         SlowMotionManager(SlowMotionManager&&) = delete;
 
-        struct ActorSlowState {
-            bool bowSlowActive = false;
-            bool castLeftActive = false;
-            bool castRightActive = false;
-            bool dualCastActive = false;
+        // Per-actor slow state, packed into one atomic word of actorStates
+        enum ActorSlowState : std::uint32_t {
+            kBowSlowActive = 1 << 0,
+            kCastLeftActive = 1 << 1,
+            kCastRightActive = 1 << 2,
+            kDualCastActive = 1 << 3,
+            kCrossbowWeapon = 1 << 4,  // Bow slowdown uses the crossbow spell
+            kFlushPending = 1u << 31,  // Queued for the next flush
         };
 
-        std::unordered_map<RE::FormID, ActorSlowState> actorStates;
-        mutable std::mutex actorStatesMutex;
+        static constexpr std::uint32_t ACTIVE_MASK = kBowSlowActive | kCastLeftActive | kCastRightActive | kDualCastActive;
+        static constexpr std::uint32_t MAX_TRACKED_ACTORS = 4096;
+        static constexpr std::uint32_t TIER_COUNT = 4;  // Novice/Apprentice/Expert/Master
+
+        // Lock-free: animation events for many actors arrive on several threads. Keyed by
+        // handle, so a recycled temporary reference never inherits another actor's state.
+        // A flush gives an actor's slot back once it has nothing wanted and nothing applied.
+        ActorSlotMap<MAX_TRACKED_ACTORS> actorStates;
+
+        // What the actor's skill asks for: an entry of the config's magnitude table
+        using DesiredEffect = MagnitudeEntry;
+
+        // Desired effects, indexed by actorStates slot; written before the actor is queued
+        std::array<std::atomic<DesiredEffect>, MAX_TRACKED_ACTORS> bowEffects{};
+        std::array<std::atomic<DesiredEffect>, MAX_TRACKED_ACTORS> castEffects{};
+        std::array<std::atomic<DesiredEffect>, MAX_TRACKED_ACTORS> dualCastEffects{};
+
+        // Effect ledger: exactly which debuff spell we have applied to each actor, and at
+        // what magnitude. An actor holds at most one bow-type and one cast-type spell, one per
+        // channel. The engine is only called when an entry changes. Indexed by actorStates
+        // slot; main thread only.
+        enum EffectChannel : std::uint32_t {
+            kBowChannel,
+            kCastChannel,
+
+            kEffectChannels
+        };
+
+        struct LedgerEntry {
+            RE::SpellItem* spell = nullptr;
+            float magnitude = 0.0f;
+        };
+
+        struct ActorLedger {
+            RE::ActorHandle handle;
+            std::array<LedgerEntry, kEffectChannels> channels{};
+        };
+
+        // Magnitudes closer than this count as unchanged
+        static constexpr float MAGNITUDE_EPSILON = 0.01f;
+
+        // SpeedMult modifier steps are multiples of this, so adding and removing them
+        // sums exactly in float and removal restores the value to the bit
+        static constexpr float MODIFIER_STEP = 1.0f / 256.0f;
+
+        std::array<ActorLedger, MAX_TRACKED_ACTORS> effectLedger{};
+
+        // Actors whose desired effects changed since the last flush. Only touched when an
+        // actor first becomes pending in a frame, and striped by handle across padded
+        // shards so threads queueing different actors rarely meet on a lock.
+        static constexpr std::size_t MAX_SYNCS_PER_FLUSH = 64;  // The rest wait for the next frame
+        static constexpr std::uint32_t PENDING_SHARD_BITS = 3;
+
+        struct alignas(64) PendingShard {
+            std::mutex mutex;
+            std::vector<RE::ActorHandle> actors;
+        };
+
+        PendingShard& ShardOf(RE::ActorHandle handle) {
+            return pendingShards[(handle.native_handle() * 0x9E3779B1u) >> (32 - PENDING_SHARD_BITS)];
+        }
+
+        std::array<PendingShard, 1u << PENDING_SHARD_BITS> pendingShards;
+        std::vector<RE::ActorHandle> flushBatch;
+        std::atomic<bool> flushScheduled = false;
+
+        std::atomic<std::uint64_t> flushCount = 0;
+        std::atomic<std::uint64_t> castCalls = 0;
+        std::atomic<std::uint64_t> dispelCalls = 0;
+        std::atomic<std::uint64_t> modifierCalls = 0;
+        std::atomic<std::uint64_t> immediateCalls = 0;
+
+        Config::SlowdownBackend backend = Config::SlowdownBackend::kSpell;
 
         // Cached spell pointers
         RE::SpellItem* bowDebuffSpell = nullptr;
@@ -47,9 +159,32 @@ namespace SIGA {
         RE::SpellItem* dualCastDebuffSpell = nullptr;
         RE::SpellItem* crossbowDebuffSpell = nullptr;
 
-        float CalculateMagnitude(float skillLevel, SlowType type);
-        void ApplySpellWithMagnitude(RE::Actor* actor, RE::SpellItem* spell, float magnitude);
-        void RemoveSpell(RE::Actor* actor, RE::SpellItem* spell);
-        bool IsActorSlowedInternal(RE::FormID formID) const;
+        // One copy of each debuff spell per tier, so casting never writes to shared spell
+        // data. Each carries its tier's magnitude, stamped at kDataLoaded and again when a
+        // reload changes the tier multipliers. CastLeft and CastRight share a row.
+        std::array<std::array<RE::SpellItem*, TIER_COUNT>, static_cast<std::size_t>(SlowType::Total)> spellVariants{};
+        static constexpr SlowType VARIANT_ROWS[] = { SlowType::Bow, SlowType::Crossbow, SlowType::CastLeft, SlowType::DualCast };
+
+        void BuildSpellVariants(const Config::Snapshot& config);
+        void StampSpellVariants(const Config::Snapshot& config);
+        static RE::SpellItem* CreateSpellVariant(RE::SpellItem* base);
+        RE::SpellItem* BaseSpellFor(SlowType type) const;
+        RE::SpellItem* VariantFor(SlowType type, std::uint32_t tier) const;
+
+        static DesiredEffect LookupEffect(const Config::Snapshot& config, SlowType type, float skillLevel);
+        static float MagnitudeForTier(const Config::Snapshot& config, SlowType type, std::uint32_t tier);
+        bool ApplySpellWithMagnitude(RE::Actor* actor, RE::SpellItem* spell, float magnitude);
+        bool RemoveSpell(RE::Actor* actor, RE::SpellItem* spell);
+        static std::uint32_t StateBitFor(SlowType type);
+
+        std::uint32_t DrainStates();
+        void MarkPending(RE::ActorHandle handle);
+        void ScheduleFlush();
+        void SyncActor(RE::ActorHandle handle, std::uint32_t slot, std::uint32_t state);
+        void ReleaseIfIdle(RE::ActorHandle handle, std::uint32_t slot, std::uint32_t state);
+        void SyncChannel(RE::Actor* actor, LedgerEntry& entry, RE::SpellItem* desiredSpell, float desiredMagnitude);
+        void SyncModifier(RE::Actor* actor, LedgerEntry& entry, RE::SpellItem* desiredSpell, float desiredMagnitude);
+        bool ModifySpeedMult(RE::Actor* actor, float delta);
+        static bool SameMagnitude(float a, float b);
     };
 }
\ No newline at end of file
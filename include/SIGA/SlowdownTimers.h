@@ -0,0 +1,89 @@
+#pragma once
+#include "SIGA/ActorSlotMap.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace SIGA {
+    // Stuck-slowdown protection for every slowed actor, player and NPC alike. Applying a
+    // slowdown arms a deadline for the actor and its animation events push it back; when
+    // one passes, the actor's slowdowns are cleared. Deadlines sit in a two-level timer
+    // wheel turned by a background thread, so a tick only touches the actors due in it.
+    class SlowdownTimers {
+    public:
+        static constexpr std::chrono::milliseconds TICK{ 100 };
+
+        static SlowdownTimers* GetSingleton() {
+            static SlowdownTimers singleton;
+            return &singleton;
+        }
+
+        // Starts the thread that ticks the wheel. Without it, the caller runs Tick itself.
+        void Start();
+        void Stop();
+
+        // Arms the actor's deadline, or moves an armed one, a_timeout seconds from now.
+        // Does nothing for a timeout of 0.
+        void Arm(RE::ActorHandle a_handle, float a_timeout);
+
+        // Moves the deadline of an actor that is armed; others are left alone
+        void Renew(RE::ActorHandle a_handle, float a_timeout);
+
+        // Advances the wheel one tick and clears the slowdowns of every actor whose
+        // deadline has passed. Returns how many actors were still slowed.
+        std::size_t Tick();
+
+        // Disarms every actor; call when a save loads
+        void Clear();
+
+        [[nodiscard]] std::uint32_t GetArmedCount() const;
+        [[nodiscard]] std::uint64_t GetExpiredCount() const { return expired.load(std::memory_order_relaxed); }
+
+    private:
+        SlowdownTimers() = default;
+        SlowdownTimers(const SlowdownTimers&) = delete;
+        SlowdownTimers(SlowdownTimers&&) = delete;
+        ~SlowdownTimers() { Stop(); }
+
+        static constexpr std::uint32_t MAX_TRACKED_ACTORS = 4096;
+
+        // 64 ticks per level: the near wheel spans 6.4 s, the far one 6.8 minutes. Later
+        // deadlines wait in the far wheel's last bucket and are placed again when it turns.
+        static constexpr std::uint32_t WHEEL_BITS = 6;
+        static constexpr std::uint32_t WHEEL_SIZE = 1 << WHEEL_BITS;
+        static constexpr std::uint32_t WHEEL_MASK = WHEEL_SIZE - 1;
+
+        // Timer word: ARMED | deadline tick. Renewing only rewrites the word; a bucket
+        // entry whose deadline has moved is placed again when its bucket comes up.
+        static constexpr std::uint32_t ARMED = 1u << 31;
+        static constexpr std::uint32_t DEADLINE_MASK = ARMED - 1;
+
+        [[nodiscard]] std::uint32_t DeadlineIn(float a_timeout) const;
+
+        // Puts an actor in the bucket for its deadline; wheelMutex held
+        void Schedule(RE::ActorHandle a_handle, std::uint32_t a_deadline);
+
+        void Run(std::stop_token a_stop);
+
+        ActorSlotMap<MAX_TRACKED_ACTORS> timers;
+        std::atomic<std::uint32_t> now = 0;
+
+        std::mutex wheelMutex;
+        std::array<std::vector<RE::ActorHandle>, WHEEL_SIZE> nearWheel;
+        std::array<std::vector<RE::ActorHandle>, WHEEL_SIZE> farWheel;
+        std::vector<RE::ActorHandle> due;
+        std::vector<RE::ActorHandle> expiredBatch;  // Only the ticking thread touches it
+
+        std::atomic<std::uint64_t> expired = 0;
+
+        std::mutex wakeMutex;
+        std::condition_variable_any wake;
+        std::jthread thread;
+    };
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace SIGA {
+    // What BeginCast needs to know about a spell, for every SpellItem in the load order.
+    // Built once after kDataLoaded on a background thread, which fans the scan out over a
+    // few workers; until it is published, and for spells created at runtime, Describe
+    // walks the spell's effects instead.
+    class SpellIndex {
+    public:
+        struct Info {
+            RE::ActorValue school = RE::ActorValue::kNone;
+            bool modifiesSpeed = false;  // An effect's primary actor value is SpeedMult
+            bool concentration = false;  // Concentration, rather than fire-and-forget
+        };
+
+        static SpellIndex* GetSingleton() {
+            static SpellIndex singleton;
+            return &singleton;
+        }
+
+        // Starts the scan of TESDataHandler's spells. Call at kDataLoaded, once.
+        void BuildAsync();
+
+        // Blocks until a started scan has been published
+        void Wait();
+
+        [[nodiscard]] bool IsReady() const { return index.load(std::memory_order_acquire) != nullptr; }
+
+        // Empty if a_spell is not a SpellItem
+        [[nodiscard]] std::optional<Info> Describe(RE::MagicItem* a_spell) const;
+
+        // The walk over the spell's effects that the index replaces
+        [[nodiscard]] static Info Scan(RE::SpellItem* a_spell);
+
+    private:
+        SpellIndex() = default;
+        SpellIndex(const SpellIndex&) = delete;
+        SpellIndex(SpellIndex&&) = delete;
+        ~SpellIndex() = default;
+
+        static constexpr std::size_t MAX_WORKERS = 4;
+
+        // 8 bytes per spell, in a power-of-two table keyed by FormID; 0 marks an empty slot
+        struct Entry {
+            RE::FormID formID;
+            std::int16_t school;
+            std::uint8_t flags;
+        };
+        static_assert(sizeof(Entry) == 8);
+
+        static constexpr std::uint8_t MODIFIES_SPEED = 1 << 0;
+        static constexpr std::uint8_t CONCENTRATION = 1 << 1;
+
+        // Fibonacci hashing takes the top bits of the product, which every FormID bit feeds;
+        // the low bits only see the low FormID bits, and plugins share those. a_shift is 32
+        // minus log2 of the table size.
+        static std::size_t SlotOf(RE::FormID a_formID, std::uint32_t a_shift) {
+            return static_cast<std::size_t>((a_formID * 0x9E3779B1u) >> a_shift);
+        }
+
+        static std::uint32_t ShiftFor(std::size_t a_tableSize) {
+            return 32 - static_cast<std::uint32_t>(std::countr_zero(a_tableSize));
+        }
+
+        static Entry MakeEntry(RE::SpellItem* a_spell);
+        void Build(std::vector<RE::SpellItem*> a_spells);
+
+        std::atomic<const std::vector<Entry>*> index = nullptr;
+        std::unique_ptr<const std::vector<Entry>> built;
+        std::jthread builder;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "SIGA/AnimEventTags.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace SIGA {
+    // Classifies animation tags by the address of their interned BSFixedString.
+    // Hot events hit a direct-mapped pointer cache and never read string bytes;
+    // misses fall back to the AnimEventTags perfect hash and fill the cache.
+    class TagClassifier {
+    public:
+        static TagClassifier* GetSingleton();
+
+        // Resolve every tag we handle to its interned pointer. Call at kDataLoaded.
+        // If any tag fails to intern, the pointer cache stays off and Classify
+        // uses the string path only.
+        bool Initialize();
+
+        AnimEventType Classify(const RE::BSFixedString& a_tag);
+
+        struct Stats {
+            std::uint64_t pointerHits = 0;    // Resolved from the cache without touching the string
+            std::uint64_t cacheFills = 0;     // Cache miss, classified by string and cached
+            std::uint64_t stringFallbacks = 0;  // Classified by string, not cacheable
+        };
+
+        Stats GetStats() const;
+        void ResetStats();
+        void LogStats() const;
+
+    private:
+        TagClassifier() = default;
+        TagClassifier(const TagClassifier&) = delete;
+        TagClassifier(TagClassifier&&) = delete;
+
+        static constexpr std::uint32_t CACHE_BITS = 10;
+        static constexpr std::uint32_t CACHE_SIZE = 1u << CACHE_BITS;
+
+        // Cache entries pack the pool pointer in the low 56 bits and the type above it
+        static constexpr std::uint32_t TYPE_SHIFT = 56;
+        static constexpr std::uintptr_t POINTER_MASK = (std::uintptr_t{ 1 } << TYPE_SHIFT) - 1;
+
+        static std::uint32_t SlotFor(std::uintptr_t a_pointer);
+        static std::uintptr_t Pack(std::uintptr_t a_pointer, AnimEventType a_type);
+
+        AnimEventType ClassifyByString(const RE::BSFixedString& a_tag);
+
+        // Holding the handles keeps our tags' pool entries, and so their addresses, alive
+        std::array<RE::BSFixedString, AnimEventTags::TAGS.size()> internedTags;
+        std::atomic<bool> pointerCacheReady = false;
+
+        alignas(64) std::array<std::atomic<std::uintptr_t>, CACHE_SIZE> cache{};
+
+        alignas(64) std::atomic<std::uint64_t> pointerHits = 0;
+        std::atomic<std::uint64_t> cacheFills = 0;
+        std::atomic<std::uint64_t> stringFallbacks = 0;
+    };
+}
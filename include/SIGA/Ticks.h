@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
+namespace SIGA {
+    // A cheap monotonic tick count for stamping events: the time stamp counter where there
+    // is one. Ticks are not nanoseconds; pair two readings with a clock to convert them.
+    inline std::uint64_t ReadTicks() {
+#if defined(_MSC_VER)
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __builtin_ia32_rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+}
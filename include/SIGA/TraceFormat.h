@@ -0,0 +1,194 @@
+#pragma once
+
+#include "SIGA/AnimEventTags.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Trace record layout and its text and Chrome trace-event forms, shared by TraceLog and
+// the siga_trace_decode tool. Deliberately free of game headers so the decoder builds anywhere.
+namespace SIGA::Trace {
+    // What a record means. Values are stored in trace files: append, never renumber.
+    enum class Format : std::uint16_t {
+        kClockSync,        // Pairs a timestamp with wall-clock time: formID/value are its low/high halves
+        kDropped,          // value records were lost because the thread's buffer was full
+        kAnimationEvent,   // value is the AnimEventType
+        kApplySlowdown,    // value is the SlowType
+        kRemoveSlowdown,   // value is the SlowType
+        kClearActor,
+        kClearAll,
+        kCastSpell,        // value is the spell's FormID
+        kDispelSpell,      // value is the spell's FormID
+        kModifySpeedMult,  // magnitude is the change
+        kConfigReload,     // value is how many actors lost a disabled slowdown
+        kSpanBegin,        // value is SpanValue(span, slow type)
+        kSpanEnd,          // value as for its kSpanBegin
+
+        kTotal
+    };
+
+    // The text for each format. Placeholders: {actor} {event} {type} {spell} {span} {value}
+    // {magnitude}
+    inline constexpr std::array<std::string_view, static_cast<std::size_t>(Format::kTotal)> FORMAT_TEXT = {
+        "clock sync",
+        "{value} records dropped",
+        "{actor} animation event {event}",
+        "{actor} apply {type} slowdown, magnitude {magnitude}",
+        "{actor} remove {type} slowdown",
+        "{actor} clear all slowdowns",
+        "clear all slowdowns for all actors",
+        "{actor} cast {spell}, magnitude {magnitude}",
+        "{actor} dispel {spell}",
+        "{actor} SpeedMult {magnitude}",
+        "config reloaded, {value} actors cleared",
+        "{span} begin {actor} {type}",
+        "{span} end",
+    };
+
+    // Timed regions, drawn as slices on a Chrome/Perfetto timeline
+    enum class Span : std::uint16_t {
+        kProcessEvent,
+        kApplySlowdown,
+        kRemoveSlowdown,
+        kClearAll,
+        kFlush,
+        kConfigLoad,
+
+        kTotal
+    };
+
+    inline constexpr std::array<std::string_view, static_cast<std::size_t>(Span::kTotal)> SPAN_NAMES = {
+        "ProcessEvent", "ApplySlowdown", "RemoveSlowdown", "ClearAll", "Flush", "Config::Load"
+    };
+
+    // In SlowType order
+    inline constexpr std::array<std::string_view, 5> SLOW_TYPE_NAMES = { "Bow", "Crossbow", "CastLeft", "CastRight", "DualCast" };
+    inline constexpr std::uint32_t NO_SLOW_TYPE = 0xFFFF;
+
+    // A span and the SlowType it works on, in one record value
+    constexpr std::uint32_t SpanValue(Span a_span, std::uint32_t a_slowType = NO_SLOW_TYPE) {
+        return static_cast<std::uint32_t>(a_span) | a_slowType << 16;
+    }
+
+    // One fixed-size record per event; arguments are stored raw and formatted later
+    struct Record {
+        std::uint64_t timestamp;  // Ticks; kClockSync records map them to wall-clock time
+        std::uint32_t formID;
+        std::uint16_t format;
+        std::uint16_t thread;     // Order in which threads first recorded
+        std::uint32_t value;
+        float magnitude;
+    };
+    static_assert(sizeof(Record) == 24);
+
+    struct FileHeader {
+        char magic[8] = { 'S', 'I', 'G', 'A', 'T', 'R', 'C', '\0' };
+        std::uint32_t version = 1;
+        std::uint32_t recordSize = sizeof(Record);
+    };
+
+    inline std::string_view SlowTypeName(std::uint32_t a_value) {
+        return a_value < SLOW_TYPE_NAMES.size() ? SLOW_TYPE_NAMES[a_value] : std::string_view{};
+    }
+
+    inline std::string_view SpanName(std::uint32_t a_value) {
+        auto span = a_value & 0xFFFF;
+        return span < SPAN_NAMES.size() ? SPAN_NAMES[span] : "?";
+    }
+
+    // The record as one line of text, from its FORMAT_TEXT
+    inline std::string Describe(const Record& a_record) {
+        if (a_record.format >= FORMAT_TEXT.size()) {
+            return "unknown format " + std::to_string(a_record.format);
+        }
+
+        bool isSpan = a_record.format == static_cast<std::uint16_t>(Format::kSpanBegin) ||
+                      a_record.format == static_cast<std::uint16_t>(Format::kSpanEnd);
+        auto text = FORMAT_TEXT[a_record.format];
+        std::string result;
+        while (!text.empty()) {
+            auto open = text.find('{');
+            auto close = text.find('}', open);
+            if (open == std::string_view::npos || close == std::string_view::npos) {
+                result += text;
+                break;
+            }
+            result += text.substr(0, open);
+            auto name = text.substr(open + 1, close - open - 1);
+            text = text.substr(close + 1);
+
+            char buffer[32] = "";
+            if (name == "actor" && a_record.formID) {
+                std::snprintf(buffer, sizeof(buffer), "%08X", a_record.formID);
+            }
+            else if (name == "spell") {
+                std::snprintf(buffer, sizeof(buffer), "%08X", a_record.value);
+            }
+            else if (name == "value") {
+                std::snprintf(buffer, sizeof(buffer), "%u", a_record.value);
+            }
+            else if (name == "magnitude") {
+                std::snprintf(buffer, sizeof(buffer), "%g", a_record.magnitude);
+            }
+            else if (name == "event") {
+                result += a_record.value < ANIM_EVENT_TYPE_COUNT ? AnimEventTags::NameOf(static_cast<AnimEventType>(a_record.value)) : "Unknown";
+            }
+            else if (name == "type") {
+                result += SlowTypeName(isSpan ? a_record.value >> 16 : a_record.value);
+            }
+            else if (name == "span") {
+                result += SpanName(a_record.value);
+            }
+            result += buffer;
+        }
+
+        while (!result.empty() && result.back() == ' ') {
+            result.pop_back();
+        }
+        return result;
+    }
+
+    // Appends the record as a Chrome trace-event JSON object, with a trailing comma and
+    // newline. a_microseconds is its time on the trace's clock. Clock syncs add nothing.
+    inline void AppendChromeEvent(std::string& a_out, const Record& a_record, double a_microseconds) {
+        char buffer[256];
+        auto format = static_cast<Format>(a_record.format);
+        switch (format) {
+        case Format::kClockSync:
+            return;
+        case Format::kSpanBegin:
+        {
+            auto name = SpanName(a_record.value);
+            auto type = SlowTypeName(a_record.value >> 16);
+            if (type.empty()) {
+                std::snprintf(buffer, sizeof(buffer),
+                    R"({"name":"%.*s","cat":"siga","ph":"B","ts":%.3f,"pid":1,"tid":%u,"args":{"formID":"%08X"}},)",
+                    static_cast<int>(name.size()), name.data(), a_microseconds, a_record.thread, a_record.formID);
+            }
+            else {
+                std::snprintf(buffer, sizeof(buffer),
+                    R"({"name":"%.*s","cat":"siga","ph":"B","ts":%.3f,"pid":1,"tid":%u,"args":{"formID":"%08X","type":"%.*s"}},)",
+                    static_cast<int>(name.size()), name.data(), a_microseconds, a_record.thread, a_record.formID,
+                    static_cast<int>(type.size()), type.data());
+            }
+            break;
+        }
+        case Format::kSpanEnd:
+            std::snprintf(buffer, sizeof(buffer), R"({"ph":"E","ts":%.3f,"pid":1,"tid":%u},)", a_microseconds, a_record.thread);
+            break;
+        default:
+        {
+            // Text made of names and hex numbers only: nothing to escape
+            auto text = Describe(a_record);
+            std::snprintf(buffer, sizeof(buffer),
+                R"({"name":"%s","cat":"siga","ph":"i","s":"t","ts":%.3f,"pid":1,"tid":%u,"args":{"formID":"%08X","magnitude":%g}},)",
+                text.c_str(), a_microseconds, a_record.thread, a_record.formID, a_record.magnitude);
+            break;
+        }
+        }
+        a_out += buffer;
+        a_out += '\n';
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "SIGA/TraceFormat.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace SIGA {
+    // High-volume tracing without formatting on the game's threads: a call site stores a
+    // format ID and its raw arguments in its thread's buffer, and a background thread
+    // appends the buffers to a file. A binary file is turned into text offline by
+    // siga_trace_decode; a Chrome trace is formatted by the background thread as it writes.
+    class TraceLog {
+    public:
+        enum class OutputFormat {
+            kBinary = 0,      // Compact; read with siga_trace_decode
+            kChromeJson = 1,  // Trace-event JSON for chrome://tracing or ui.perfetto.dev
+        };
+
+        static TraceLog* GetSingleton() {
+            static TraceLog singleton;
+            return &singleton;
+        }
+
+        // Where records go; the file is created when tracing is first enabled
+        void SetOutput(std::filesystem::path a_path, OutputFormat a_format = OutputFormat::kBinary);
+        void SetEnabled(bool a_enabled);
+        [[nodiscard]] bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+        // One relaxed load when disabled; a timestamp and one buffer write when enabled
+        void Record(Trace::Format a_format, RE::FormID a_formID, std::uint32_t a_value = 0, float a_magnitude = 0.0f) {
+            if (IsEnabled()) {
+                Append(a_format, a_formID, a_value, a_magnitude);
+            }
+        }
+
+        // Records a span around its scope, for timelines. The end is recorded if the begin
+        // was, so spans stay balanced when tracing is switched off inside one.
+        class ScopedSpan {
+        public:
+            explicit ScopedSpan(Trace::Span a_span, RE::FormID a_formID = 0, std::uint32_t a_slowType = Trace::NO_SLOW_TYPE) :
+                formID(a_formID), value(Trace::SpanValue(a_span, a_slowType)), active(GetSingleton()->IsEnabled()) {
+                if (active) {
+                    GetSingleton()->Append(Trace::Format::kSpanBegin, formID, value, 0.0f);
+                }
+            }
+            ~ScopedSpan() {
+                if (active) {
+                    GetSingleton()->Append(Trace::Format::kSpanEnd, formID, value, 0.0f);
+                }
+            }
+
+            ScopedSpan(const ScopedSpan&) = delete;
+            ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+        private:
+            RE::FormID formID;
+            std::uint32_t value;
+            bool active;
+        };
+
+        // Writes every buffered record out. The writer thread does this every WRITE_INTERVAL.
+        void Drain();
+
+        // Disables tracing, stops the writer thread and closes the file. Tracing again needs
+        // a new SetOutput.
+        void Close();
+
+        struct Stats {
+            std::uint64_t written = 0;
+            std::uint64_t dropped = 0;
+        };
+
+        Stats GetStats() const;
+
+    private:
+        TraceLog() = default;
+        TraceLog(const TraceLog&) = delete;
+        TraceLog(TraceLog&&) = delete;
+        ~TraceLog() { Close(); }
+
+        static constexpr std::uint32_t BUFFER_RECORDS = 8192;  // Per thread; power of two
+        static constexpr auto WRITE_INTERVAL = std::chrono::milliseconds(10);
+
+        // Single producer (its thread), single consumer (Drain)
+        struct ThreadBuffer {
+            std::array<Trace::Record, BUFFER_RECORDS> records;
+            alignas(64) std::atomic<std::uint32_t> head = 0;
+            alignas(64) std::atomic<std::uint32_t> tail = 0;
+            std::atomic<std::uint32_t> dropped = 0;
+            std::uint16_t thread = 0;
+        };
+
+        void Append(Trace::Format a_format, RE::FormID a_formID, std::uint32_t a_value, float a_magnitude);
+        ThreadBuffer* RegisterThread();
+        void WriteClockSync();
+        void WriteChromeEvents(const Trace::Record* a_records, std::uint32_t a_count);
+        void Run(std::stop_token a_stop);
+
+        std::atomic<bool> enabled = false;
+
+        // Buffers are never freed: a thread may still hold its pointer
+        std::mutex buffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        // Drain and the file
+        mutable std::mutex drainMutex;
+        std::filesystem::path path;
+        OutputFormat format = OutputFormat::kBinary;
+        std::FILE* file = nullptr;
+        std::string chromeBuffer;
+
+        // Chrome timestamps: microseconds since tracing was enabled, at a tick rate measured
+        // once the first time records are written
+        std::uint64_t baseTicks = 0;
+        std::chrono::steady_clock::time_point baseTime;
+        double microsecondsPerTick = 0.0;
+        std::uint64_t written = 0;
+        std::uint64_t dropped = 0;
+
+        std::mutex wakeMutex;
+        std::condition_variable_any wake;
+        std::jthread writer;
+    };
+}
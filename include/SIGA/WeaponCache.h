@@ -0,0 +1,69 @@
+#pragma once
+#include "SIGA/ActorSlotMap.h"
+
+namespace SIGA {
+    // What each tracked actor has equipped for ranged attacks, so a redraw reads one table
+    // word instead of querying the engine. Filled when an actor is registered; TESEquipEvent
+    // marks it stale and the next read resolves it again, once the equip has settled. Keyed
+    // by handle like the slowdown state, and an actor's slot is freed when it is forgotten.
+    class WeaponCache : public RE::BSTEventSink<RE::TESEquipEvent> {
+    public:
+        enum class Ranged : std::uint32_t {
+            kNone = 0,  // Nothing, or not a bow or crossbow
+            kBow = 1,
+            kCrossbow = 2,
+        };
+
+        static WeaponCache* GetSingleton() {
+            static WeaponCache singleton;
+            return &singleton;
+        }
+
+        // The actor's right-hand ranged weapon; queries the engine, and starts tracking the
+        // actor, only if its entry is stale or missing
+        [[nodiscard]] Ranged GetRanged(RE::Actor* a_actor);
+
+        // Starts tracking an actor from its current equipment
+        void Refresh(RE::Actor* a_actor);
+
+        // Marks the actor's entry stale, if it has one
+        void Invalidate(RE::ActorHandle a_handle);
+
+        // Stops tracking the actor and frees its slot; call when its sink comes off
+        void Forget(RE::ActorHandle a_handle);
+
+        // Drops every entry; call when a save loads
+        void Clear();
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::TESEquipEvent* a_event,
+            RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource) override;
+
+        // Reads that had to query the engine; cache hits are not counted, to keep them cheap
+        [[nodiscard]] std::uint64_t GetResolveCount() const;
+        void ResetResolveCount();
+
+        static Ranged QueryEngine(RE::Actor* a_actor);
+
+    private:
+        WeaponCache() = default;
+        WeaponCache(const WeaponCache&) = delete;
+        WeaponCache(WeaponCache&&) = delete;
+        ~WeaponCache() = default;
+
+        static constexpr std::uint32_t MAX_TRACKED_ACTORS = 1024;
+
+        // Entry word: generation << 8 | RESOLVED | ranged type. An equip event bumps the
+        // generation and clears RESOLVED, so a resolve that raced it cannot store an old
+        // weapon over the change.
+        static constexpr std::uint32_t RESOLVED = 0x80;
+        static constexpr std::uint32_t TYPE_MASK = 0x7F;
+        static constexpr std::uint32_t GENERATION_STEP = 0x100;
+
+        Ranged Resolve(RE::Actor* a_actor, std::uint32_t a_seen, bool a_insert);
+
+        ActorSlotMap<MAX_TRACKED_ACTORS> entries;
+
+        std::atomic<std::uint64_t> resolves = 0;
+    };
+}
@@ -0,0 +1,603 @@
+#pragma once
+
+// Minimal stand-in for CommonLibSSE's RE layer, used by the host build of
+// SIGACore and siga_bench. Only what SIGA touches is modelled, with the same
+// names and signatures as CommonLibSSE-NG so src/ compiles unchanged against both.
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace SKSE::stl {
+    // An enum stored in a fixed-width integer, as the engine lays them out
+    template <class E, class U = std::underlying_type_t<E>>
+    class enumeration {
+    public:
+        constexpr enumeration() noexcept = default;
+        constexpr enumeration(E a_value) noexcept : _impl(static_cast<U>(a_value)) {}
+
+        [[nodiscard]] constexpr E get() const noexcept { return static_cast<E>(_impl); }
+        [[nodiscard]] constexpr U underlying() const noexcept { return _impl; }
+
+    private:
+        U _impl = 0;
+    };
+}
+
+namespace RE {
+    namespace stl = SKSE::stl;
+
+    using FormID = std::uint32_t;
+
+    enum class FormType : std::uint8_t {
+        None = 0,
+        MagicEffect = 18,
+        Spell = 22,
+        Weapon = 41,
+        Reference = 61,
+        ActorCharacter = 62,
+    };
+
+    enum class ActorValue : std::int32_t {
+        kNone = -1,
+        kArchery = 8,
+        kAlteration = 18,
+        kConjuration = 19,
+        kDestruction = 20,
+        kIllusion = 21,
+        kRestoration = 22,
+        kSpeedMult = 30,
+        kCarryWeight = 32,
+        kTotal = 164
+    };
+
+    enum class WEAPON_TYPE : std::uint8_t {
+        kHandToHandMelee = 0,
+        kOneHandSword = 1,
+        kOneHandDagger = 2,
+        kOneHandAxe = 3,
+        kOneHandMace = 4,
+        kTwoHandSword = 5,
+        kTwoHandAxe = 6,
+        kBow = 7,
+        kStaff = 8,
+        kCrossbow = 9
+    };
+
+    namespace MagicSystem {
+        enum class CastingSource : std::uint32_t {
+            kLeftHand = 0,
+            kRightHand = 1,
+            kOther = 2,
+            kInstant = 3
+        };
+
+        enum class SpellType : std::uint32_t {
+            kSpell = 0,
+            kDisease = 1,
+            kPower = 2,
+            kLesserPower = 3,
+            kAbility = 4,
+            kPoison = 5,
+            kEnchantment = 6
+        };
+
+        enum class CastingType : std::uint32_t {
+            kConstantEffect = 0,
+            kFireAndForget = 1,
+            kConcentration = 2,
+            kScroll = 3
+        };
+
+        enum class Delivery : std::uint32_t {
+            kSelf = 0,
+            kTouch = 1,
+            kAimed = 2,
+            kTargetActor = 3,
+            kTargetLocation = 4
+        };
+    }
+
+    enum class BSEventNotifyControl {
+        kContinue = 0,
+        kStop = 1
+    };
+
+    template <class T>
+    using BSTArray = std::vector<T>;
+
+    // Interned string: equal text always yields the same data() pointer.
+    class BSFixedString {
+    public:
+        using size_type = std::uint32_t;
+
+        BSFixedString() = default;
+        BSFixedString(const char* a_string) : _data(Intern(a_string ? std::string_view(a_string) : std::string_view())) {}
+        BSFixedString(std::string_view a_string) : _data(Intern(a_string)) {}
+
+        [[nodiscard]] const char* data() const noexcept { return _data ? _data->c_str() : ""; }
+        [[nodiscard]] const char* c_str() const noexcept { return data(); }
+        [[nodiscard]] size_type size() const noexcept { return _data ? static_cast<size_type>(_data->size()) : 0; }
+        [[nodiscard]] size_type length() const noexcept { return size(); }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        operator std::string_view() const noexcept { return { data(), size() }; }
+
+    private:
+        static const std::string* Intern(std::string_view a_string);
+
+        const std::string* _data = nullptr;
+    };
+
+    class TESForm {
+    public:
+        virtual ~TESForm() = default;
+
+        template <class T>
+        [[nodiscard]] T* As() noexcept {
+            return formType == T::FORMTYPE ? static_cast<T*>(this) : nullptr;
+        }
+
+        template <class T>
+        [[nodiscard]] const T* As() const noexcept {
+            return formType == T::FORMTYPE ? static_cast<const T*>(this) : nullptr;
+        }
+
+        template <class T = TESForm>
+        [[nodiscard]] static T* LookupByID(FormID a_formID) {
+            auto form = LookupFormByID(a_formID);
+            return form ? form->As<T>() : nullptr;
+        }
+
+        [[nodiscard]] FormID GetFormID() const noexcept { return formID; }
+        [[nodiscard]] FormType GetFormType() const noexcept { return formType; }
+        [[nodiscard]] virtual const char* GetName() const { return fullName.c_str(); }
+
+        // Mock only: forms must be registered to be found by LookupByID.
+        static void RegisterForm(TESForm* a_form);
+        static void UnregisterForm(TESForm* a_form);
+
+        FormID formID = 0;
+        FormType formType = FormType::None;
+        std::string fullName;
+
+    private:
+        static TESForm* LookupFormByID(FormID a_formID);
+    };
+
+    class EffectSetting : public TESForm {
+    public:
+        static constexpr auto FORMTYPE = FormType::MagicEffect;
+
+        struct EffectSettingData {
+            ActorValue primaryAV = ActorValue::kNone;
+        };
+
+        EffectSetting() { formType = FORMTYPE; }
+
+        EffectSettingData data;
+    };
+
+    class Effect {
+    public:
+        struct EffectItem {
+            float magnitude = 0.0f;
+            std::uint32_t area = 0;
+            std::uint32_t duration = 0;
+        };
+
+        EffectItem effectItem;
+        EffectSetting* baseEffect = nullptr;
+        float cost = 0.0f;
+    };
+
+    class MagicItem : public TESForm {
+    public:
+        [[nodiscard]] ActorValue GetAssociatedSkill() const { return associatedSkill; }
+
+        BSTArray<Effect*> effects;
+
+        // Mock only: CommonLibSSE derives this from the costliest effect.
+        ActorValue associatedSkill = ActorValue::kNone;
+    };
+
+    class SpellItem : public MagicItem {
+    public:
+        static constexpr auto FORMTYPE = FormType::Spell;
+
+        struct Data {
+            std::int32_t costOverride = 0;
+            std::uint32_t flags = 0;
+            MagicSystem::SpellType spellType = MagicSystem::SpellType::kSpell;
+            float chargeTime = 0.0f;
+            MagicSystem::CastingType castingType = MagicSystem::CastingType::kFireAndForget;
+            MagicSystem::Delivery delivery = MagicSystem::Delivery::kSelf;
+            float castDuration = 0.0f;
+            float range = 0.0f;
+        };
+
+        SpellItem() { formType = FORMTYPE; }
+
+        [[nodiscard]] MagicSystem::CastingType GetCastingType() const { return data.castingType; }
+
+        Data data;
+    };
+
+    namespace Mock {
+        // Next FormID in the 0xFF dynamic range, as the engine hands out to runtime forms
+        FormID NextDynamicFormID();
+    }
+
+    template <class T>
+    class ConcreteFormFactory;
+
+    class IFormFactory {
+    public:
+        template <class T>
+        [[nodiscard]] static ConcreteFormFactory<T>* GetConcreteFormFactoryByType() {
+            static ConcreteFormFactory<T> factory;
+            return &factory;
+        }
+    };
+
+    template <class T>
+    class ConcreteFormFactory : public IFormFactory {
+    public:
+        // Runtime forms live until the game exits, as in the engine
+        [[nodiscard]] T* Create() {
+            auto form = new T();
+            form->formID = Mock::NextDynamicFormID();
+            TESForm::RegisterForm(form);
+            return form;
+        }
+    };
+
+    class TESObjectWEAP : public TESForm {
+    public:
+        static constexpr auto FORMTYPE = FormType::Weapon;
+
+        TESObjectWEAP() { formType = FORMTYPE; }
+
+        [[nodiscard]] WEAPON_TYPE GetWeaponType() const noexcept { return weaponType; }
+
+        WEAPON_TYPE weaponType = WEAPON_TYPE::kBow;
+    };
+
+    class TESObjectREFR;
+    class Actor;
+
+    // Mock only: no reference counting; the bench fixture owns its forms
+    template <class T>
+    class NiPointer {
+    public:
+        NiPointer(T* a_pointer = nullptr) noexcept : _pointer(a_pointer) {}
+
+        [[nodiscard]] T* get() const noexcept { return _pointer; }
+        T* operator->() const noexcept { return _pointer; }
+        explicit operator bool() const noexcept { return _pointer != nullptr; }
+
+    private:
+        T* _pointer = nullptr;
+    };
+
+    namespace Mock {
+        // The engine's handle table. A handle is the table index in its low 20 bits, then a
+        // 6-bit age bumped each time the index is reused, then an active bit.
+        std::uint32_t CreateHandle(const TESObjectREFR* a_ref);
+        TESObjectREFR* LookupHandle(std::uint32_t a_handle);
+
+        // The reference is deleted: its handle goes stale and the index is free for reuse
+        void ReleaseHandle(const TESObjectREFR* a_ref);
+    }
+
+    template <class T>
+    class BSPointerHandle {
+    public:
+        BSPointerHandle() = default;
+        explicit BSPointerHandle(std::uint32_t a_handle) noexcept : _handle(a_handle) {}
+
+        // Null once the reference is gone, even if its index has been reused
+        [[nodiscard]] NiPointer<T> get() const {
+            return NiPointer<T>(static_cast<T*>(Mock::LookupHandle(_handle)));
+        }
+
+        [[nodiscard]] std::uint32_t native_handle() const noexcept { return _handle; }
+        explicit operator bool() const noexcept { return _handle != 0; }
+        bool operator==(const BSPointerHandle&) const = default;
+
+    private:
+        std::uint32_t _handle = 0;
+    };
+
+    using ActorHandle = BSPointerHandle<Actor>;
+    using ObjectRefHandle = BSPointerHandle<TESObjectREFR>;
+
+    class MagicCaster {
+    public:
+        void CastSpellImmediate(MagicItem* a_spell, bool a_noHitEffectArt, TESObjectREFR* a_target,
+            float a_effectiveness, bool a_hostileEffectivenessOnly, float a_magnitudeOverride, Actor* a_blameActor);
+    };
+
+    // Mock only: the engine's ActiveEffect is far larger; this keeps what a cast allocates
+    class ActiveEffect {
+    public:
+        MagicItem* spell = nullptr;
+        float magnitude = 0.0f;
+    };
+
+    class MagicTarget {
+    public:
+        bool DispelEffect(MagicItem* a_spell, BSPointerHandle<Actor>& a_caster, ActiveEffect* a_effect = nullptr);
+
+        // Mock only: effects CastSpellImmediate has applied to this target
+        std::vector<std::unique_ptr<ActiveEffect>> activeEffects;
+    };
+
+    enum class ACTOR_VALUE_MODIFIER {
+        kPermanent = 0,
+        kTemporary = 1,
+        kDamage = 2,
+
+        kTotal = 3
+    };
+
+    class ActorValueOwner {
+    public:
+        virtual ~ActorValueOwner() = default;
+
+        [[nodiscard]] virtual float GetActorValue(ActorValue a_akValue);
+        virtual void ModActorValue(ActorValue a_akValue, float a_value);
+        virtual void RestoreActorValue(ACTOR_VALUE_MODIFIER a_modifier, ActorValue a_akValue, float a_value);
+
+        // Mock only
+        void SetValue(ActorValue a_akValue, float a_value) { values[Index(a_akValue)] = a_value; }
+        [[nodiscard]] float GetModifier(ACTOR_VALUE_MODIFIER a_modifier, ActorValue a_akValue) const {
+            return modifiers[static_cast<std::size_t>(a_modifier)][Index(a_akValue)];
+        }
+
+    private:
+        static std::size_t Index(ActorValue a_akValue) { return static_cast<std::size_t>(a_akValue); }
+
+        std::array<float, static_cast<std::size_t>(ActorValue::kTotal)> values{};
+        std::array<std::array<float, static_cast<std::size_t>(ActorValue::kTotal)>, static_cast<std::size_t>(ACTOR_VALUE_MODIFIER::kTotal)> modifiers{};
+    };
+
+    template <class Event>
+    class BSTEventSource;
+
+    template <class Event>
+    class BSTEventSink {
+    public:
+        virtual ~BSTEventSink() = default;
+        virtual BSEventNotifyControl ProcessEvent(const Event* a_event, BSTEventSource<Event>* a_eventSource) = 0;
+    };
+
+    template <class Event>
+    class BSTEventSource {
+    public:
+        void AddEventSink(BSTEventSink<Event>* a_sink) {
+            std::lock_guard lock(_lock);
+            for (auto sink : _sinks) {
+                if (sink == a_sink) {
+                    return;
+                }
+            }
+            _sinks.push_back(a_sink);
+        }
+
+        void RemoveEventSink(BSTEventSink<Event>* a_sink) {
+            std::lock_guard lock(_lock);
+            std::erase(_sinks, a_sink);
+        }
+
+        void SendEvent(const Event* a_event) {
+            std::lock_guard lock(_lock);
+            for (auto sink : _sinks) {
+                if (sink->ProcessEvent(a_event, this) == BSEventNotifyControl::kStop) {
+                    break;
+                }
+            }
+        }
+
+        [[nodiscard]] std::size_t GetSinkCount() {
+            std::lock_guard lock(_lock);
+            return _sinks.size();
+        }
+
+    private:
+        std::mutex _lock;
+        std::vector<BSTEventSink<Event>*> _sinks;
+    };
+
+    class BSAnimationGraphEvent {
+    public:
+        const BSFixedString tag;
+        const TESObjectREFR* holder = nullptr;
+        const BSFixedString payload;
+    };
+
+    class TESObjectREFR : public TESForm {
+    public:
+        static constexpr auto FORMTYPE = FormType::Reference;
+
+        TESObjectREFR() { formType = FORMTYPE; }
+
+        [[nodiscard]] bool IsPlayerRef() const noexcept { return formID == 0x14; }
+
+        [[nodiscard]] ObjectRefHandle GetHandle() const { return ObjectRefHandle(Mock::CreateHandle(this)); }
+
+        // Mock only: the engine keeps the handle's index in the reference's refcount bits
+        mutable std::atomic<std::uint32_t> handle = 0;
+    };
+
+    class Actor : public TESObjectREFR {
+    public:
+        static constexpr auto FORMTYPE = FormType::ActorCharacter;
+
+        struct SlotTypes {
+            enum : std::uint32_t {
+                kLeftHand = 0,
+                kRightHand,
+                kUnknown,
+                kPowerOrShout,
+
+                kTotal
+            };
+        };
+
+        struct ACTOR_RUNTIME_DATA {
+            MagicItem* selectedSpells[SlotTypes::kTotal]{};
+        };
+
+        Actor() { formType = FORMTYPE; }
+
+        [[nodiscard]] ActorHandle GetHandle() const { return ActorHandle(Mock::CreateHandle(this)); }
+
+        [[nodiscard]] ACTOR_RUNTIME_DATA& GetActorRuntimeData() noexcept { return runtimeData; }
+        [[nodiscard]] const ACTOR_RUNTIME_DATA& GetActorRuntimeData() const noexcept { return runtimeData; }
+
+        [[nodiscard]] bool IsInCombat() const noexcept { return inCombat; }
+        [[nodiscard]] ActorValueOwner* AsActorValueOwner() noexcept { return &actorValues; }
+        [[nodiscard]] TESForm* GetEquippedObject(bool a_leftHand) const noexcept { return a_leftHand ? equippedLeft : equippedRight; }
+        [[nodiscard]] MagicCaster* GetMagicCaster(MagicSystem::CastingSource) noexcept { return &magicCaster; }
+        [[nodiscard]] MagicTarget* GetMagicTarget() noexcept { return &magicTarget; }
+
+        bool AddAnimationGraphEventSink(BSTEventSink<BSAnimationGraphEvent>* a_sink) const {
+            if (!hasAnimationGraph) {
+                return false;
+            }
+            animationGraphEventSource.AddEventSink(a_sink);
+            return true;
+        }
+
+        void RemoveAnimationGraphEventSink(BSTEventSink<BSAnimationGraphEvent>* a_sink) const {
+            animationGraphEventSource.RemoveEventSink(a_sink);
+        }
+
+        // Mock only: state the real engine derives elsewhere
+        bool inCombat = false;
+        bool hasAnimationGraph = true;  // False until the 3D loads
+        TESForm* equippedLeft = nullptr;
+        TESForm* equippedRight = nullptr;
+        mutable BSTEventSource<BSAnimationGraphEvent> animationGraphEventSource;
+
+    private:
+        ACTOR_RUNTIME_DATA runtimeData;
+        ActorValueOwner actorValues;
+        MagicCaster magicCaster;
+        MagicTarget magicTarget;
+    };
+
+    enum class ACTOR_COMBAT_STATE : std::uint32_t {
+        kNone = 0,
+        kCombat = 1,
+        kSearching = 2,
+    };
+
+    struct TESCombatEvent {
+        NiPointer<TESObjectREFR> actor;
+        NiPointer<TESObjectREFR> targetActor;
+        stl::enumeration<ACTOR_COMBAT_STATE, std::uint32_t> newState;
+    };
+
+    struct TESDeathEvent {
+        NiPointer<TESObjectREFR> actorDying;
+        NiPointer<TESObjectREFR> actorKiller;
+        bool dead = false;
+    };
+
+    struct TESCellAttachDetachEvent {
+        NiPointer<TESObjectREFR> reference;
+        bool attached = false;
+    };
+
+    struct TESEquipEvent {
+        NiPointer<TESObjectREFR> actor;
+        FormID baseObject = 0;
+        FormID originalRefr = 0;
+        std::uint16_t uniqueID = 0;
+        bool equipped = false;
+    };
+
+    struct TESObjectLoadedEvent {
+        FormID formID = 0;
+        bool loaded = false;
+    };
+
+    struct TESSwitchRaceCompleteEvent {
+        NiPointer<TESObjectREFR> subject;
+    };
+
+    class PlayerCharacter : public Actor {
+    public:
+        static PlayerCharacter* GetSingleton();
+
+    private:
+        PlayerCharacter() { formID = 0x14; }
+    };
+
+    struct SkillIncrease {
+        struct Event {
+            NiPointer<PlayerCharacter> player;
+            ActorValue actorValue = ActorValue::kNone;
+        };
+
+        static BSTEventSource<Event>* GetEventSource();
+    };
+
+    struct LevelIncrease {
+        struct Event {
+            PlayerCharacter* player = nullptr;
+            std::uint16_t newLevel = 0;
+        };
+
+        static BSTEventSource<Event>* GetEventSource();
+    };
+
+    class TESDataHandler {
+    public:
+        static TESDataHandler* GetSingleton();
+
+        template <class T>
+        [[nodiscard]] T* LookupForm(FormID a_localFormID, std::string_view a_modName) {
+            auto form = LookupPluginForm(a_localFormID, a_modName);
+            return form ? form->As<T>() : nullptr;
+        }
+
+        // Every loaded form of one type. Mock only: forms are added by pushing onto the array.
+        template <class T>
+        [[nodiscard]] BSTArray<T*>& GetFormArray() {
+            static BSTArray<T*> forms;
+            return forms;
+        }
+
+        // Mock only: make a form visible to LookupForm under a plugin-local ID.
+        void RegisterPluginForm(TESForm* a_form, FormID a_localFormID, std::string_view a_modName);
+
+    private:
+        TESForm* LookupPluginForm(FormID a_localFormID, std::string_view a_modName);
+
+        std::mutex lock;
+        std::unordered_map<std::string, TESForm*> pluginForms;
+    };
+
+    // Mock only: counts of the engine calls SIGA makes, for benchmarks.
+    namespace Mock {
+        struct EngineCallCounters {
+            std::atomic<std::uint64_t> castSpellImmediate{ 0 };
+            std::atomic<std::uint64_t> dispelEffect{ 0 };
+            std::atomic<std::uint64_t> actorValueMods{ 0 };
+        };
+
+        EngineCallCounters& GetEngineCallCounters();
+        void ResetEngineCallCounters();
+    }
+}
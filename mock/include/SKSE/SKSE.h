@@ -0,0 +1,37 @@
+#pragma once
+
+// Minimal stand-in for CommonLibSSE's SKSE layer for the host build.
+// Logging forwards straight to spdlog, like SKSE::log does in game.
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+
+#include <spdlog/spdlog.h>
+
+namespace SKSE {
+    namespace log {
+        using spdlog::trace;
+        using spdlog::debug;
+        using spdlog::info;
+        using spdlog::warn;
+        using spdlog::error;
+        using spdlog::critical;
+
+        std::optional<std::filesystem::path> log_directory();
+    }
+
+    // Tasks queue up until the host plays the main thread's end of frame
+    class TaskInterface {
+    public:
+        void AddTask(std::function<void()> a_task) const;
+    };
+
+    const TaskInterface* GetTaskInterface() noexcept;
+
+    // Mock only
+    namespace Mock {
+        // Runs every queued task, as the game does once per frame; returns how many ran
+        std::size_t RunQueuedTasks();
+    }
+}
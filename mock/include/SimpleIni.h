@@ -0,0 +1,207 @@
+#pragma once
+
+// Minimal stand-in for SimpleIni's CSimpleIniA for the host build: flat
+// [section] key=value files with ';' comments, which is all SIGA.ini uses.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum SI_Error {
+    SI_OK = 0,
+    SI_UPDATED = 1,
+    SI_INSERTED = 2,
+    SI_FAIL = -1,
+    SI_NOMEM = -2,
+    SI_FILE = -3
+};
+
+class CSimpleIniA {
+public:
+    void SetUnicode(bool = true) {}
+
+    SI_Error LoadFile(const char* a_pszFile) {
+        std::ifstream file(a_pszFile, std::ios::binary);
+        if (!file) {
+            return SI_FILE;
+        }
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return LoadData(data);
+    }
+
+    SI_Error LoadData(const std::string& a_strData) { return LoadData(a_strData.data(), a_strData.size()); }
+
+    SI_Error LoadData(const char* a_pData, std::size_t a_uDataLen) {
+        sections.clear();
+        std::istringstream stream(std::string(a_pData, a_uDataLen));
+        std::string line;
+        Section* current = nullptr;
+        while (std::getline(stream, line)) {
+            auto text = Trim(line);
+            if (text.empty() || text[0] == ';' || text[0] == '#') {
+                continue;
+            }
+            if (text.front() == '[' && text.back() == ']') {
+                current = &GetOrAddSection(Trim(text.substr(1, text.size() - 2)));
+                continue;
+            }
+            auto eq = text.find('=');
+            if (!current || eq == std::string::npos) {
+                continue;
+            }
+            SetEntry(*current, Trim(text.substr(0, eq)), Trim(text.substr(eq + 1)));
+        }
+        return SI_OK;
+    }
+
+    SI_Error SaveFile(const char* a_pszFile, bool = true) const {
+        std::ofstream file(a_pszFile, std::ios::trunc);
+        if (!file) {
+            return SI_FILE;
+        }
+
+        for (auto& section : sections) {
+            file << '[' << section.name << "]\n";
+            for (auto& comment : section.comments) {
+                file << comment << '\n';
+            }
+            for (auto& [key, value] : section.entries) {
+                file << key << " = " << value << '\n';
+            }
+            file << '\n';
+        }
+        return file ? SI_OK : SI_FILE;
+    }
+
+    const char* GetValue(const char* a_pSection, const char* a_pKey, const char* a_pDefault = nullptr, bool* = nullptr) const {
+        auto value = Find(a_pSection, a_pKey);
+        return value ? value->c_str() : a_pDefault;
+    }
+
+    bool GetBoolValue(const char* a_pSection, const char* a_pKey, bool a_bDefault = false, bool* = nullptr) const {
+        auto value = Find(a_pSection, a_pKey);
+        if (!value || value->empty()) {
+            return a_bDefault;
+        }
+        switch ((*value)[0]) {
+        case 't': case 'T': case 'y': case 'Y': case '1':
+            return true;
+        case 'f': case 'F': case 'n': case 'N': case '0':
+            return false;
+        case 'o': case 'O':
+            return value->size() > 1 && ((*value)[1] == 'n' || (*value)[1] == 'N');
+        default:
+            return a_bDefault;
+        }
+    }
+
+    long GetLongValue(const char* a_pSection, const char* a_pKey, long a_nDefault = 0, bool* = nullptr) const {
+        auto value = Find(a_pSection, a_pKey);
+        if (!value || value->empty()) {
+            return a_nDefault;
+        }
+        char* end = nullptr;
+        long result = std::strtol(value->c_str(), &end, 0);
+        return end == value->c_str() ? a_nDefault : result;
+    }
+
+    double GetDoubleValue(const char* a_pSection, const char* a_pKey, double a_nDefault = 0, bool* = nullptr) const {
+        auto value = Find(a_pSection, a_pKey);
+        if (!value || value->empty()) {
+            return a_nDefault;
+        }
+        char* end = nullptr;
+        double result = std::strtod(value->c_str(), &end);
+        return end == value->c_str() ? a_nDefault : result;
+    }
+
+    SI_Error SetValue(const char* a_pSection, const char* a_pKey, const char* a_pValue, const char* a_pComment = nullptr, bool = false) {
+        auto& section = GetOrAddSection(a_pSection);
+        if (!a_pKey) {
+            // A null key only creates the section; SIGA uses it to attach comment lines.
+            if (a_pValue && a_pValue[0] == ';') {
+                section.comments.emplace_back(a_pValue);
+            }
+            return SI_OK;
+        }
+        if (a_pComment) {
+            section.comments.emplace_back(a_pComment);
+        }
+        SetEntry(section, a_pKey, a_pValue ? a_pValue : "");
+        return SI_OK;
+    }
+
+    SI_Error SetBoolValue(const char* a_pSection, const char* a_pKey, bool a_bValue, const char* a_pComment = nullptr, bool a_bForceReplace = false) {
+        return SetValue(a_pSection, a_pKey, a_bValue ? "true" : "false", a_pComment, a_bForceReplace);
+    }
+
+    SI_Error SetLongValue(const char* a_pSection, const char* a_pKey, long a_nValue, const char* a_pComment = nullptr, bool = false, bool a_bForceReplace = false) {
+        return SetValue(a_pSection, a_pKey, std::to_string(a_nValue).c_str(), a_pComment, a_bForceReplace);
+    }
+
+    SI_Error SetDoubleValue(const char* a_pSection, const char* a_pKey, double a_nValue, const char* a_pComment = nullptr, bool a_bForceReplace = false) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%f", a_nValue);
+        return SetValue(a_pSection, a_pKey, buffer, a_pComment, a_bForceReplace);
+    }
+
+private:
+    struct Section {
+        std::string name;
+        std::vector<std::string> comments;
+        std::vector<std::pair<std::string, std::string>> entries;
+    };
+
+    static std::string Trim(const std::string& a_text) {
+        auto first = a_text.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos) {
+            return {};
+        }
+        auto last = a_text.find_last_not_of(" \t\r\n");
+        return a_text.substr(first, last - first + 1);
+    }
+
+    Section& GetOrAddSection(const std::string& a_name) {
+        for (auto& section : sections) {
+            if (section.name == a_name) {
+                return section;
+            }
+        }
+        return sections.emplace_back(Section{ a_name, {}, {} });
+    }
+
+    static void SetEntry(Section& a_section, const std::string& a_key, const std::string& a_value) {
+        for (auto& [key, value] : a_section.entries) {
+            if (key == a_key) {
+                value = a_value;
+                return;
+            }
+        }
+        a_section.entries.emplace_back(a_key, a_value);
+    }
+
+    const std::string* Find(const char* a_pSection, const char* a_pKey) const {
+        if (!a_pSection || !a_pKey) {
+            return nullptr;
+        }
+        for (auto& section : sections) {
+            if (section.name != a_pSection) {
+                continue;
+            }
+            for (auto& [key, value] : section.entries) {
+                if (key == a_pKey) {
+                    return &value;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<Section> sections;
+};
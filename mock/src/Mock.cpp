@@ -0,0 +1,284 @@
+#include <RE/Skyrim.h>
+#include <SKSE/SKSE.h>
+
+namespace RE {
+    namespace {
+        struct StringPool {
+            std::mutex lock;
+            std::unordered_map<std::string_view, std::unique_ptr<std::string>> strings;
+        };
+
+        StringPool& GetStringPool() {
+            static StringPool pool;
+            return pool;
+        }
+
+        struct FormRegistry {
+            std::mutex lock;
+            std::unordered_map<FormID, TESForm*> forms;
+        };
+
+        FormRegistry& GetFormRegistry() {
+            static FormRegistry registry;
+            return registry;
+        }
+
+        std::string MakePluginKey(FormID a_localFormID, std::string_view a_modName) {
+            return std::string(a_modName) + ':' + std::to_string(a_localFormID & 0xFFF);
+        }
+
+        // Reads are lock-free, as in the engine; creating and releasing handles takes the lock
+        struct HandleTable {
+            static constexpr std::uint32_t INDEX_MASK = 0xFFFFF;
+            static constexpr std::uint32_t AGE_SHIFT = 20;
+            static constexpr std::uint32_t AGE_MASK = 0x3F;
+            static constexpr std::uint32_t ACTIVE = 1u << 26;
+            static constexpr std::uint32_t SIZE = 1u << 16;
+
+            struct Entry {
+                std::atomic<std::uint32_t> handle = 0;
+                std::atomic<TESObjectREFR*> ref = nullptr;
+                std::uint32_t age = 0;
+            };
+
+            std::mutex lock;
+            std::array<Entry, SIZE> entries;
+            std::vector<std::uint32_t> freeList;
+            std::uint32_t nextIndex = 1;  // Index 0 is never a valid handle
+        };
+
+        HandleTable& GetHandleTable() {
+            static HandleTable table;
+            return table;
+        }
+    }
+
+    const std::string* BSFixedString::Intern(std::string_view a_string) {
+        if (a_string.empty()) {
+            return nullptr;
+        }
+
+        auto& pool = GetStringPool();
+        std::lock_guard lock(pool.lock);
+        auto it = pool.strings.find(a_string);
+        if (it != pool.strings.end()) {
+            return it->second.get();
+        }
+
+        auto entry = std::make_unique<std::string>(a_string);
+        auto result = entry.get();
+        pool.strings.emplace(std::string_view(*result), std::move(entry));
+        return result;
+    }
+
+    void TESForm::RegisterForm(TESForm* a_form) {
+        auto& registry = GetFormRegistry();
+        std::lock_guard lock(registry.lock);
+        registry.forms[a_form->formID] = a_form;
+    }
+
+    void TESForm::UnregisterForm(TESForm* a_form) {
+        auto& registry = GetFormRegistry();
+        std::lock_guard lock(registry.lock);
+        auto it = registry.forms.find(a_form->formID);
+        if (it != registry.forms.end() && it->second == a_form) {
+            registry.forms.erase(it);
+        }
+    }
+
+    TESForm* TESForm::LookupFormByID(FormID a_formID) {
+        auto& registry = GetFormRegistry();
+        std::lock_guard lock(registry.lock);
+        auto it = registry.forms.find(a_formID);
+        return it != registry.forms.end() ? it->second : nullptr;
+    }
+
+    void MagicCaster::CastSpellImmediate(MagicItem* a_spell, bool, TESObjectREFR* a_target, float, bool, float a_magnitudeOverride, Actor*) {
+        Mock::GetEngineCallCounters().castSpellImmediate.fetch_add(1, std::memory_order_relaxed);
+
+        // Like the engine, a recast replaces the spell's effect with a freshly allocated one
+        auto actor = a_target ? a_target->As<Actor>() : nullptr;
+        if (!actor) {
+            return;
+        }
+        auto& effects = actor->GetMagicTarget()->activeEffects;
+        std::erase_if(effects, [a_spell](auto& a_effect) { return a_effect->spell == a_spell; });
+        auto effect = std::make_unique<ActiveEffect>();
+        effect->spell = a_spell;
+        effect->magnitude = a_magnitudeOverride;
+        effects.push_back(std::move(effect));
+    }
+
+    bool MagicTarget::DispelEffect(MagicItem* a_spell, BSPointerHandle<Actor>&, ActiveEffect*) {
+        Mock::GetEngineCallCounters().dispelEffect.fetch_add(1, std::memory_order_relaxed);
+        return std::erase_if(activeEffects, [a_spell](auto& a_effect) { return a_effect->spell == a_spell; }) != 0;
+    }
+
+    float ActorValueOwner::GetActorValue(ActorValue a_akValue) {
+        auto index = Index(a_akValue);
+        return values[index] + modifiers[0][index] + modifiers[1][index] + modifiers[2][index];
+    }
+
+    void ActorValueOwner::ModActorValue(ActorValue a_akValue, float a_value) {
+        RestoreActorValue(ACTOR_VALUE_MODIFIER::kPermanent, a_akValue, a_value);
+    }
+
+    void ActorValueOwner::RestoreActorValue(ACTOR_VALUE_MODIFIER a_modifier, ActorValue a_akValue, float a_value) {
+        Mock::GetEngineCallCounters().actorValueMods.fetch_add(1, std::memory_order_relaxed);
+        modifiers[static_cast<std::size_t>(a_modifier)][Index(a_akValue)] += a_value;
+    }
+
+    PlayerCharacter* PlayerCharacter::GetSingleton() {
+        static PlayerCharacter singleton;
+        return &singleton;
+    }
+
+    BSTEventSource<SkillIncrease::Event>* SkillIncrease::GetEventSource() {
+        static BSTEventSource<Event> source;
+        return &source;
+    }
+
+    BSTEventSource<LevelIncrease::Event>* LevelIncrease::GetEventSource() {
+        static BSTEventSource<Event> source;
+        return &source;
+    }
+
+    TESDataHandler* TESDataHandler::GetSingleton() {
+        static TESDataHandler singleton;
+        return &singleton;
+    }
+
+    void TESDataHandler::RegisterPluginForm(TESForm* a_form, FormID a_localFormID, std::string_view a_modName) {
+        std::lock_guard guard(lock);
+        pluginForms[MakePluginKey(a_localFormID, a_modName)] = a_form;
+    }
+
+    TESForm* TESDataHandler::LookupPluginForm(FormID a_localFormID, std::string_view a_modName) {
+        std::lock_guard guard(lock);
+        auto it = pluginForms.find(MakePluginKey(a_localFormID, a_modName));
+        return it != pluginForms.end() ? it->second : nullptr;
+    }
+
+    namespace Mock {
+        std::uint32_t CreateHandle(const TESObjectREFR* a_ref) {
+            if (auto handle = a_ref->handle.load(std::memory_order_acquire)) {
+                return handle;
+            }
+
+            auto& table = GetHandleTable();
+            std::lock_guard lock(table.lock);
+            if (auto handle = a_ref->handle.load(std::memory_order_relaxed)) {
+                return handle;
+            }
+
+            std::uint32_t index;
+            if (!table.freeList.empty()) {
+                // LIFO, so a deleted reference's index is the next one handed out
+                index = table.freeList.back();
+                table.freeList.pop_back();
+            }
+            else if (table.nextIndex < HandleTable::SIZE) {
+                index = table.nextIndex++;
+            }
+            else {
+                return 0;
+            }
+
+            auto& entry = table.entries[index];
+            auto handle = index | (entry.age & HandleTable::AGE_MASK) << HandleTable::AGE_SHIFT | HandleTable::ACTIVE;
+            entry.ref.store(const_cast<TESObjectREFR*>(a_ref), std::memory_order_relaxed);
+            entry.handle.store(handle, std::memory_order_release);
+            a_ref->handle.store(handle, std::memory_order_release);
+            return handle;
+        }
+
+        TESObjectREFR* LookupHandle(std::uint32_t a_handle) {
+            auto index = a_handle & HandleTable::INDEX_MASK;
+            if (a_handle == 0 || index >= HandleTable::SIZE) {
+                return nullptr;
+            }
+            auto& entry = GetHandleTable().entries[index];
+            auto ref = entry.ref.load(std::memory_order_acquire);
+            return entry.handle.load(std::memory_order_acquire) == a_handle ? ref : nullptr;
+        }
+
+        void ReleaseHandle(const TESObjectREFR* a_ref) {
+            auto& table = GetHandleTable();
+            std::lock_guard lock(table.lock);
+            auto handle = a_ref->handle.exchange(0, std::memory_order_acq_rel);
+            if (!handle) {
+                return;
+            }
+
+            auto index = handle & HandleTable::INDEX_MASK;
+            auto& entry = table.entries[index];
+            entry.handle.store(0, std::memory_order_release);
+            entry.ref.store(nullptr, std::memory_order_release);
+            ++entry.age;
+            table.freeList.push_back(index);
+        }
+
+        EngineCallCounters& GetEngineCallCounters() {
+            static EngineCallCounters counters;
+            return counters;
+        }
+
+        FormID NextDynamicFormID() {
+            static std::atomic<FormID> next{ 0xFF000800 };
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void ResetEngineCallCounters() {
+            auto& counters = GetEngineCallCounters();
+            counters.castSpellImmediate.store(0);
+            counters.dispelEffect.store(0);
+            counters.actorValueMods.store(0);
+        }
+    }
+}
+
+namespace SKSE {
+    namespace {
+        struct TaskQueue {
+            std::mutex lock;
+            std::vector<std::function<void()>> tasks;
+        };
+
+        TaskQueue& GetTaskQueue() {
+            static TaskQueue queue;
+            return queue;
+        }
+    }
+
+    namespace log {
+        std::optional<std::filesystem::path> log_directory() {
+            return std::filesystem::temp_directory_path();
+        }
+    }
+
+    void TaskInterface::AddTask(std::function<void()> a_task) const {
+        auto& queue = GetTaskQueue();
+        std::lock_guard lock(queue.lock);
+        queue.tasks.push_back(std::move(a_task));
+    }
+
+    const TaskInterface* GetTaskInterface() noexcept {
+        static TaskInterface taskInterface;
+        return &taskInterface;
+    }
+
+    namespace Mock {
+        std::size_t RunQueuedTasks() {
+            auto& queue = GetTaskQueue();
+            std::vector<std::function<void()>> tasks;
+            {
+                std::lock_guard lock(queue.lock);
+                tasks.swap(queue.tasks);
+            }
+            for (auto& task : tasks) {
+                task();
+            }
+            return tasks.size();
+        }
+    }
+}
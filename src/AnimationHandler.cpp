@@ -1,38 +1,18 @@
 #include "SIGA/AnimationHandler.h"
+#include "SIGA/CombatEventHandler.h"
 #include "SIGA/SlowMotion.h"
+#include "SIGA/SpellIndex.h"
 #include "SIGA/Config.h"
-#include <unordered_map>
+#include "SIGA/TagClassifier.h"
+#include "SIGA/Log.h"
+#include "SIGA/Metrics.h"
+#include "SIGA/SkillCache.h"
+#include "SIGA/SlowdownTimers.h"
+#include "SIGA/TraceLog.h"
+#include "SIGA/WeaponCache.h"
 
 namespace SIGA {
 
-    // OPTIMIZATION: Event type enum for fast switch instead of string comparisons
-    enum class AnimEventType {
-        Unknown,
-        BowDrawn,
-        BowRelease,
-        BeginCastLeft,
-        BeginCastRight,
-        CastStop,
-        CastOKStop,
-        InterruptCast,
-        AttackStop,
-        WeaponSheathe,
-    };
-
-    // OPTIMIZATION: Hash map for O(1) event lookup instead of O(n) string comparisons
-    static const std::unordered_map<std::string_view, AnimEventType> EVENT_LOOKUP = {
-        {"BowDrawn", AnimEventType::BowDrawn},
-        {"bowRelease", AnimEventType::BowRelease},
-        {"BeginCastLeft", AnimEventType::BeginCastLeft},
-        {"BeginCastRight", AnimEventType::BeginCastRight},
-        {"CastStop", AnimEventType::CastStop},
-        {"CastOKStop", AnimEventType::CastOKStop},
-        {"InterruptCast", AnimEventType::InterruptCast},
-        {"attackStop", AnimEventType::AttackStop},
-        {"WeaponSheathe", AnimEventType::WeaponSheathe},
-        {"weaponSheathe", AnimEventType::WeaponSheathe},
-    };
-
     AnimationEventHandler* AnimationEventHandler::GetSingleton() {
         static AnimationEventHandler singleton;
         return &singleton;
@@ -42,95 +22,180 @@ namespace SIGA {
         const RE::BSAnimationGraphEvent* a_event,
         RE::BSTEventSource<RE::BSAnimationGraphEvent>* a_eventSource)
     {
+        auto metrics = Metrics::GetSingleton();
+        metrics->Count(Metrics::Counter::kProcessEvent);
+
         if (!a_event || !a_event->holder) {
+            metrics->Count(Metrics::Counter::kRejectNoActor);
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        // OPTIMIZATION: Cheapest and most selective checks first. Nearly every tag is
+        // irrelevant, and tags are interned, so classify by pool pointer before touching
+        // the actor; only cache misses fall back to the perfect hash over the string.
+        auto eventType = TagClassifier::GetSingleton()->Classify(a_event->tag);
+        metrics->CountEvent(eventType);
+        if (eventType == AnimEventType::Unknown) {
+            metrics->Count(Metrics::Counter::kRejectUnknownTag);
+            // Unknown event, ignore
             return RE::BSEventNotifyControl::kContinue;
         }
 
         auto actor = const_cast<RE::Actor*>(a_event->holder->As<RE::Actor>());
         if (!actor) {
+            metrics->Count(Metrics::Counter::kRejectNoActor);
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        // NPCs not registered as combatants are turned away by one bit, kept by combat events
+        if (!actor->IsPlayerRef() && !CombatEventHandler::GetSingleton()->IsEligible(actor->GetFormID())) {
+            metrics->Count(Metrics::Counter::kRejectNotEligible);
             return RE::BSEventNotifyControl::kContinue;
         }
 
-        // Handle player
+        // OPTIMIZATION: Hand the event to the main thread and return; config, state and
+        // engine calls all happen in the drain, off the animation thread
+        if (!eventQueue.TryPush(QueuedEvent{ actor->GetHandle(), eventType, ReadTicks() })) {
+            metrics->Count(Metrics::Counter::kRejectQueueFull);
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return RE::BSEventNotifyControl::kContinue;
+        }
+        ScheduleDrain();
+
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    void AnimationEventHandler::ScheduleDrain() {
+        // Pairs with the exchange in DrainEvents. Both are read-modify-writes on one flag,
+        // so whichever comes second sees the other: either this push finds the flag cleared
+        // and schedules a drain, or the drain that cleared it sees the pushed cell.
+        if (drainScheduled.exchange(true, std::memory_order_seq_cst)) {
+            return;
+        }
+
+        // SKSE hands the task interface out before any sink is registered. Without it there
+        // is no main thread to drain on, and draining here would put several animation
+        // threads on the queue's single consumer side; the events wait, and a full queue
+        // turns the rest away.
+        if (auto taskInterface = SKSE::GetTaskInterface()) {
+            taskInterface->AddTask([this]() { DrainEvents(); });
+        }
+    }
+
+    void AnimationEventHandler::DrainEvents() {
+        // Clear the flag first: anything queued after this point schedules the next drain
+        drainScheduled.exchange(false, std::memory_order_seq_cst);
+
+        // One snapshot for the whole batch; a reload mid-batch cannot mix old and new settings
+        auto config = Config::GetSingleton()->GetSnapshot();
+        auto metrics = Metrics::GetSingleton();
+
+        auto handled = eventQueue.Drain([&](const QueuedEvent& a_queued) {
+            metrics->RecordSince(Metrics::Histogram::kEventQueueDelay, a_queued.ticks);
+
+            // The reference may have been deleted, or its handle reused, since it was queued
+            auto actor = a_queued.handle.get();
+            if (!actor) {
+                metrics->Count(Metrics::Counter::kRejectNoActor);
+                return;
+            }
+            HandleEvent(actor.get(), a_queued.type, config);
+        });
+
+        if (auto dropped = droppedEvents.exchange(0, std::memory_order_relaxed)) {
+            logger::warn("Animation event queue full, dropped {} event(s)", dropped);
+        }
+
+        // The slowdowns this batch changed take effect this frame, not after another task
+        if (handled) {
+            SlowMotionManager::GetSingleton()->Flush();
+        }
+    }
+
+    void AnimationEventHandler::DiscardQueued() {
+        auto discarded = eventQueue.Drain([](const QueuedEvent&) {});
+        SIGA_LOG_DEBUG("Discarded {} queued animation event(s)", discarded);
+    }
+
+    void AnimationEventHandler::HandleEvent(RE::Actor* actor, AnimEventType eventType, const Config::Snapshot* config) {
+        auto metrics = Metrics::GetSingleton();
         bool isPlayer = actor->IsPlayerRef();
+        TraceLog::ScopedSpan span(Trace::Span::kProcessEvent, actor->GetFormID());
 
         // Handle NPCs
         if (!isPlayer) {
-            auto config = Config::GetSingleton();
-
             // Check if NPC support is enabled
             if (!config->applyToNPCs) {
-                return RE::BSEventNotifyControl::kContinue;
+                metrics->Count(Metrics::Counter::kRejectNPCsDisabled);
+                return;
             }
 
-            // Check if NPC is in combat
+            // Eligibility bits are shared between actors; confirm with the engine
             if (!actor->IsInCombat()) {
-                return RE::BSEventNotifyControl::kContinue;
+                metrics->Count(Metrics::Counter::kRejectNotInCombat);
+                return;
             }
 
             // NPC passed all checks, process the event
-            logger::trace("Processing NPC event: {}", actor->GetName());
+            SIGA_LOG_TRACE("Processing NPC event: {}", actor->GetName());
         }
 
-        std::string_view eventName = a_event->tag;
+        auto eventName = AnimEventTags::NameOf(eventType);
 
-        // OPTIMIZATION: Single hash lookup instead of multiple string comparisons
-        auto eventIt = EVENT_LOOKUP.find(eventName);
-        if (eventIt == EVENT_LOOKUP.end()) {
-            // Unknown event, ignore
-            return RE::BSEventNotifyControl::kContinue;
-        }
+        SIGA_LOG_TRACE("Animation event: '{}' from {}", eventName, isPlayer ? "Player" : actor->GetName());
+        TraceLog::GetSingleton()->Record(Trace::Format::kAnimationEvent, actor->GetFormID(), static_cast<std::uint32_t>(eventType));
 
-        logger::trace("Animation event: '{}' from {}", eventName, isPlayer ? "Player" : actor->GetName());
+        // Activity from a slowed actor keeps its stuck-slowdown deadline away
+        SlowdownTimers::GetSingleton()->Renew(actor->GetHandle(), config->stuckSlowdownTimeout);
 
         auto slowMgr = SlowMotionManager::GetSingleton();
 
         // OPTIMIZATION: Switch on enum instead of string comparisons
-        switch (eventIt->second) {
+        switch (eventType) {
         case AnimEventType::BowDrawn:
-            logger::debug("Bow drawn event");
-            OnBowDrawn(actor);
+            SIGA_LOG_DEBUG("Bow drawn event");
+            OnBowDrawn(actor, config);
             break;
 
         case AnimEventType::BowRelease:
-            logger::debug("Bow release event");
+            SIGA_LOG_DEBUG("Bow release event");
             slowMgr->RemoveSlowdown(actor, SlowType::Bow);
             slowMgr->RemoveSlowdown(actor, SlowType::Crossbow);
             break;
 
         case AnimEventType::BeginCastLeft:
-            logger::debug("BeginCastLeft event");
-            OnBeginCastLeft(actor);
+            SIGA_LOG_DEBUG("BeginCastLeft event");
+            OnBeginCastLeft(actor, config);
             break;
 
         case AnimEventType::BeginCastRight:
-            logger::debug("BeginCastRight event");
-            OnBeginCastRight(actor);
+            SIGA_LOG_DEBUG("BeginCastRight event");
+            OnBeginCastRight(actor, config);
             break;
 
         case AnimEventType::CastStop:
-            logger::debug("CastStop event");
+            SIGA_LOG_DEBUG("CastStop event");
             OnCastRelease(actor);
             break;
 
         case AnimEventType::CastOKStop:
         case AnimEventType::InterruptCast:
             if (slowMgr->IsActorSlowed(actor)) {
-                logger::debug("Cast interrupted: {}", eventName);
+                SIGA_LOG_DEBUG("Cast interrupted: {}", eventName);
                 OnCastRelease(actor);
             }
             break;
 
         case AnimEventType::AttackStop:
             if (slowMgr->IsActorSlowed(actor)) {
-                logger::debug("attackStop while slowed - clearing slowdowns");
+                SIGA_LOG_DEBUG("attackStop while slowed - clearing slowdowns");
                 OnAttackStop(actor);
             }
             break;
 
         case AnimEventType::WeaponSheathe:
             if (slowMgr->IsActorSlowed(actor)) {
-                logger::debug("Weapon state changed - clearing slowdowns");
+                SIGA_LOG_DEBUG("Weapon state changed - clearing slowdowns");
                 slowMgr->ClearAllSlowdowns(actor);
             }
             break;
@@ -138,62 +203,49 @@ namespace SIGA {
         default:
             break;
         }
-
-        return RE::BSEventNotifyControl::kContinue;
     }
 
-    void AnimationEventHandler::OnBowDrawn(RE::Actor* actor) {
-        auto config = Config::GetSingleton();
-
+    void AnimationEventHandler::OnBowDrawn(RE::Actor* actor, const Config::Snapshot* config) {
         bool isPlayer = actor->IsPlayerRef();
 
         // Check if slowdown should apply based on actor type
         if (config->applySlowdownCastingToNPCsOnly) {
             // NPCs only mode - skip player
             if (isPlayer) {
-                logger::trace("Bow slowdown skipped for player (NPCs only mode)");
+                SIGA_LOG_TRACE("Bow slowdown skipped for player (NPCs only mode)");
                 return;
             }
         }
         else {
             // Normal mode - NPCs need applyToNPCs enabled
             if (!isPlayer && !config->applyToNPCs) {
-                logger::trace("Bow slowdown disabled for NPCs");
+                SIGA_LOG_TRACE("Bow slowdown disabled for NPCs");
                 return;
             }
         }
 
-        float archerySkill = actor->AsActorValueOwner()->GetActorValue(RE::ActorValue::kArchery);
+        float archerySkill = SkillCache::GetSingleton()->GetSkill(actor, RE::ActorValue::kArchery);
 
-        // Determine weapon type
-        auto equippedObject = actor->GetEquippedObject(false);
-        bool isCrossbow = false;
-
-        if (equippedObject) {
-            auto weapon = equippedObject->As<RE::TESObjectWEAP>();
-            if (weapon) {
-                isCrossbow = (weapon->GetWeaponType() == RE::WEAPON_TYPE::kCrossbow);
-            }
-        }
+        // OPTIMIZATION: Weapon type from the equip-driven cache; archers redraw constantly
+        bool isCrossbow = WeaponCache::GetSingleton()->GetRanged(actor) == WeaponCache::Ranged::kCrossbow;
 
         SlowType type = isCrossbow ? SlowType::Crossbow : SlowType::Bow;
 
         // Check if this type is enabled
         if (isCrossbow && !config->enableCrossbowDebuff) {
-            logger::debug("Crossbow debuff disabled in config");
+            SIGA_LOG_DEBUG("Crossbow debuff disabled in config");
             return;
         }
         if (!isCrossbow && !config->enableBowDebuff) {
-            logger::debug("Bow debuff disabled in config");
+            SIGA_LOG_DEBUG("Bow debuff disabled in config");
             return;
         }
 
-        logger::debug("Applying {} slowdown (skill: {})", isCrossbow ? "crossbow" : "bow", archerySkill);
-        SlowMotionManager::GetSingleton()->ApplySlowdown(actor, type, archerySkill);
+        SIGA_LOG_DEBUG("Applying {} slowdown (skill: {})", isCrossbow ? "crossbow" : "bow", archerySkill);
+        SlowMotionManager::GetSingleton()->ApplySlowdown(actor, type, archerySkill, config);
     }
 
-    void AnimationEventHandler::OnBeginCastLeft(RE::Actor* actor) {
-        auto config = Config::GetSingleton();
+    void AnimationEventHandler::OnBeginCastLeft(RE::Actor* actor, const Config::Snapshot* config) {
         if (!config->enableCastDebuff) {
             return;
         }
@@ -204,36 +256,37 @@ namespace SIGA {
         if (config->applySlowdownCastingToNPCsOnly) {
             // NPCs only mode - skip player
             if (isPlayer) {
-                logger::trace("Casting slowdown skipped for player (NPCs only mode)");
+                SIGA_LOG_TRACE("Casting slowdown skipped for player (NPCs only mode)");
                 return;
             }
         }
         else {
             // Normal mode - NPCs need applyToNPCs enabled
             if (!isPlayer && !config->applyToNPCs) {
-                logger::trace("Casting slowdown disabled for NPCs");
+                SIGA_LOG_TRACE("Casting slowdown disabled for NPCs");
                 return;
             }
         }
 
         auto leftSpell = actor->GetActorRuntimeData().selectedSpells[RE::Actor::SlotTypes::kLeftHand];
         if (!leftSpell) {
-            logger::debug("No spell in left hand");
+            SIGA_LOG_DEBUG("No spell in left hand");
             return;
         }
 
-        if (SpellModifiesSpeed(leftSpell)) {
-            logger::debug("Left spell modifies speed - skipping slowdown");
+        // OPTIMIZATION: One lookup in the spell index instead of walking the spell's effects
+        auto spellInfo = SpellIndex::GetSingleton()->Describe(leftSpell);
+        if (spellInfo && spellInfo->modifiesSpeed) {
+            SIGA_LOG_DEBUG("Left spell modifies speed - skipping slowdown");
             return;
         }
 
-        float skillLevel = GetMagicSkillLevel(actor, leftSpell);
-        logger::debug("Left hand: {} (skill: {})", leftSpell->GetName(), skillLevel);
-        SlowMotionManager::GetSingleton()->ApplySlowdown(actor, SlowType::CastLeft, skillLevel);
+        float skillLevel = GetMagicSkillLevel(actor, spellInfo);
+        SIGA_LOG_DEBUG("Left hand: {} (skill: {})", leftSpell->GetName(), skillLevel);
+        SlowMotionManager::GetSingleton()->ApplySlowdown(actor, SlowType::CastLeft, skillLevel, config);
     }
 
-    void AnimationEventHandler::OnBeginCastRight(RE::Actor* actor) {
-        auto config = Config::GetSingleton();
+    void AnimationEventHandler::OnBeginCastRight(RE::Actor* actor, const Config::Snapshot* config) {
         if (!config->enableCastDebuff) {
             return;
         }
@@ -244,32 +297,34 @@ namespace SIGA {
         if (config->applySlowdownCastingToNPCsOnly) {
             // NPCs only mode - skip player
             if (isPlayer) {
-                logger::trace("Casting slowdown skipped for player (NPCs only mode)");
+                SIGA_LOG_TRACE("Casting slowdown skipped for player (NPCs only mode)");
                 return;
             }
         }
         else {
             // Normal mode - NPCs need applyToNPCs enabled
             if (!isPlayer && !config->applyToNPCs) {
-                logger::trace("Casting slowdown disabled for NPCs");
+                SIGA_LOG_TRACE("Casting slowdown disabled for NPCs");
                 return;
             }
         }
 
         auto rightSpell = actor->GetActorRuntimeData().selectedSpells[RE::Actor::SlotTypes::kRightHand];
         if (!rightSpell) {
-            logger::debug("No spell in right hand");
+            SIGA_LOG_DEBUG("No spell in right hand");
             return;
         }
 
-        if (SpellModifiesSpeed(rightSpell)) {
-            logger::debug("Right spell modifies speed - skipping slowdown");
+        // OPTIMIZATION: One lookup in the spell index instead of walking the spell's effects
+        auto spellInfo = SpellIndex::GetSingleton()->Describe(rightSpell);
+        if (spellInfo && spellInfo->modifiesSpeed) {
+            SIGA_LOG_DEBUG("Right spell modifies speed - skipping slowdown");
             return;
         }
 
-        float skillLevel = GetMagicSkillLevel(actor, rightSpell);
-        logger::debug("Right hand: {} (skill: {})", rightSpell->GetName(), skillLevel);
-        SlowMotionManager::GetSingleton()->ApplySlowdown(actor, SlowType::CastRight, skillLevel);
+        float skillLevel = GetMagicSkillLevel(actor, spellInfo);
+        SIGA_LOG_DEBUG("Right hand: {} (skill: {})", rightSpell->GetName(), skillLevel);
+        SlowMotionManager::GetSingleton()->ApplySlowdown(actor, SlowType::CastRight, skillLevel, config);
     }
 
     void AnimationEventHandler::OnCastRelease(RE::Actor* actor) {
@@ -277,54 +332,29 @@ namespace SIGA {
         slowMgr->RemoveSlowdown(actor, SlowType::CastLeft);
         slowMgr->RemoveSlowdown(actor, SlowType::CastRight);
         slowMgr->RemoveSlowdown(actor, SlowType::DualCast);
-        logger::debug("Cast released, removed all casting slowdowns");
+        SIGA_LOG_DEBUG("Cast released, removed all casting slowdowns");
     }
 
     void AnimationEventHandler::OnAttackStop(RE::Actor* actor) {
         SlowMotionManager::GetSingleton()->ClearAllSlowdowns(actor);
     }
 
-    float AnimationEventHandler::GetMagicSkillLevel(RE::Actor* actor, RE::MagicItem* spell) {
-        if (!spell) return 0.0f;
-
-        auto spellItem = spell->As<RE::SpellItem>();
-        if (!spellItem) {
+    float AnimationEventHandler::GetMagicSkillLevel(RE::Actor* actor, const std::optional<SpellIndex::Info>& spellInfo) {
+        if (!spellInfo) {
             logger::warn("Could not cast spell to SpellItem");
             return 0.0f;
         }
 
-        auto avOwner = actor->AsActorValueOwner();
-        auto school = spellItem->GetAssociatedSkill();
+        // OPTIMIZATION: Skills come from the per-actor cache, not the actor value system
+        auto skills = SkillCache::GetSingleton();
+        auto school = spellInfo->school;
 
         if (school == RE::ActorValue::kNone) {
             // Average all magic schools
-            float total = 0.0f;
-            total += avOwner->GetActorValue(RE::ActorValue::kDestruction);
-            total += avOwner->GetActorValue(RE::ActorValue::kRestoration);
-            total += avOwner->GetActorValue(RE::ActorValue::kAlteration);
-            total += avOwner->GetActorValue(RE::ActorValue::kConjuration);
-            total += avOwner->GetActorValue(RE::ActorValue::kIllusion);
-            return total * 0.2f;
-        }
-
-        return avOwner->GetActorValue(school);
-    }
-
-    bool AnimationEventHandler::SpellModifiesSpeed(RE::MagicItem* spell) {
-        if (!spell) return false;
-
-        auto spellItem = spell->As<RE::SpellItem>();
-        if (!spellItem) return false;
-
-        for (auto effect : spellItem->effects) {
-            if (effect && effect->baseEffect) {
-                if (effect->baseEffect->data.primaryAV == RE::ActorValue::kSpeedMult) {
-                    return true;
-                }
-            }
+            return skills->GetMagicAverage(actor);
         }
 
-        return false;
+        return skills->GetSkill(actor, school);
     }
 
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "SIGA/CombatEventHandler.h"
 #include "SIGA/AnimationHandler.h"
 #include "SIGA/Config.h"
+#include "SIGA/Log.h"
+#include "SIGA/Metrics.h"
+#include "SIGA/SkillCache.h"
+#include "SIGA/SlowMotion.h"
+#include "SIGA/WeaponCache.h"
 
 namespace SIGA {
 
@@ -12,11 +17,6 @@ namespace SIGA {
             return RE::BSEventNotifyControl::kContinue;
         }
 
-        auto config = Config::GetSingleton();
-        if (!config->applyToNPCs) {
-            return RE::BSEventNotifyControl::kContinue;
-        }
-
         // Get the actor entering/leaving combat
         auto actorPtr = a_event->actor.get();
         if (!actorPtr || actorPtr->IsPlayerRef()) {
@@ -28,29 +28,120 @@ namespace SIGA {
             return RE::BSEventNotifyControl::kContinue;
         }
 
+        // Left combat; searching still counts as in combat
+        if (a_event->newState.underlying() == 0) {
+            Unregister(actor, "left combat");
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        auto config = Config::GetSingleton()->GetSnapshot();
+        if (!config->applyToNPCs) {
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
         // Check if entering combat
         if (a_event->newState.underlying() == 1) {
-            std::lock_guard<std::mutex> lock(registrationMutex);
-
             auto formID = actor->GetFormID();
 
-            // Check if already registered
-            if (registeredNPCs.find(formID) != registeredNPCs.end()) {
-                return RE::BSEventNotifyControl::kContinue;
+            // Claim the actor first, so a second combat event for it stops here. The
+            // engine calls below run unlocked and only touch this actor.
+            {
+                Metrics::TimedLock lock(registrationMutex, Metrics::Lock::kRegistration);
+                if (!registeredNPCs.insert(formID).second) {
+                    return RE::BSEventNotifyControl::kContinue;
+                }
             }
 
             // Try to register animation events
-            if (actor->AddAnimationGraphEventSink(AnimationEventHandler::GetSingleton())) {
-                registeredNPCs.insert(formID);
-                logger::debug("Registered animation events for NPC: {} (FormID: {:X})",
-                    actor->GetName(), formID);
+            if (!actor->AddAnimationGraphEventSink(AnimationEventHandler::GetSingleton())) {
+                {
+                    Metrics::TimedLock lock(registrationMutex, Metrics::Lock::kRegistration);
+                    registeredNPCs.erase(formID);
+                }
+                SIGA_LOG_DEBUG("Failed to register for NPC: {}", actor->GetName());
+                return RE::BSEventNotifyControl::kContinue;
             }
-            else {
-                logger::debug("Failed to register for NPC: {}", actor->GetName());
+
+            WeaponCache::GetSingleton()->Refresh(actor);
+            SkillCache::GetSingleton()->Invalidate(actor->GetHandle());
+
+            bool registered;
+            {
+                Metrics::TimedLock lock(registrationMutex, Metrics::Lock::kRegistration);
+                // An unregister while the sink was going on has already given up the claim
+                registered = registeredNPCs.contains(formID);
+                if (registered) {
+                    eligibility.Set(formID);
+                }
             }
+            if (!registered) {
+                actor->RemoveAnimationGraphEventSink(AnimationEventHandler::GetSingleton());
+                return RE::BSEventNotifyControl::kContinue;
+            }
+            SIGA_LOG_DEBUG("Registered animation events for NPC: {} (FormID: {:X})",
+                actor->GetName(), formID);
+        }
+
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    RE::BSEventNotifyControl CombatEventHandler::ProcessEvent(
+        const RE::TESDeathEvent* a_event,
+        RE::BSTEventSource<RE::TESDeathEvent>* a_eventSource)
+    {
+        if (a_event) {
+            Unregister(a_event->actorDying.get(), "died");
         }
+        return RE::BSEventNotifyControl::kContinue;
+    }
 
+    RE::BSEventNotifyControl CombatEventHandler::ProcessEvent(
+        const RE::TESCellAttachDetachEvent* a_event,
+        RE::BSTEventSource<RE::TESCellAttachDetachEvent>* a_eventSource)
+    {
+        // An unloaded actor's graph goes with its 3D; re-entering combat registers it again
+        if (a_event && !a_event->attached) {
+            Unregister(a_event->reference.get(), "unloaded");
+        }
         return RE::BSEventNotifyControl::kContinue;
     }
 
+    std::size_t CombatEventHandler::GetRegisteredCount() {
+        Metrics::TimedLock lock(registrationMutex, Metrics::Lock::kRegistration);
+        return registeredNPCs.size();
+    }
+
+    void CombatEventHandler::Clear() {
+        Metrics::TimedLock lock(registrationMutex, Metrics::Lock::kRegistration);
+        registeredNPCs.clear();
+        eligibility.Assign(registeredNPCs);
+    }
+
+    void CombatEventHandler::Unregister(RE::TESObjectREFR* a_reference, const char* a_reason) {
+        if (!a_reference || a_reference->IsPlayerRef()) {
+            return;
+        }
+
+        auto actor = a_reference->As<RE::Actor>();
+        if (!actor) {
+            return;
+        }
+
+        {
+            Metrics::TimedLock lock(registrationMutex, Metrics::Lock::kRegistration);
+            if (registeredNPCs.erase(actor->GetFormID()) == 0) {
+                return;
+            }
+            // Bits are shared, so the set is rebuilt rather than this one bit cleared
+            eligibility.Assign(registeredNPCs);
+        }
+
+        actor->RemoveAnimationGraphEventSink(AnimationEventHandler::GetSingleton());
+        WeaponCache::GetSingleton()->Forget(actor->GetHandle());
+        SkillCache::GetSingleton()->Forget(actor->GetHandle());
+        SlowMotionManager::GetSingleton()->ClearAllSlowdowns(actor);
+        SIGA_LOG_DEBUG("Unregistered animation events for NPC: {} (FormID: {:X}, {})",
+            actor->GetName(), actor->GetFormID(), a_reason);
+    }
+
 }
\ No newline at end of file
@@ -1,110 +1,232 @@
 #include "SIGA/Config.h"
+#include "SIGA/TraceLog.h"
 #include <SimpleIni.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
 
 namespace SIGA {
+    Config::Config() {
+        // Readers always find a snapshot, even before SIGA.ini is loaded
+        Publish(Snapshot{});
+    }
+
     std::filesystem::path Config::GetConfigPath() {
         auto path = std::filesystem::current_path() / "Data" / "SKSE" / "Plugins" / "SIGA.ini";
         return path;
     }
 
     void Config::Load() {
-        CSimpleIniA ini;
-        ini.SetUnicode();
-
+        TraceLog::ScopedSpan span(Trace::Span::kConfigLoad);
         auto path = GetConfigPath();
 
-        if (ini.LoadFile(path.string().c_str()) < 0) {
+        auto text = ReadFile(path);
+        if (!text) {
             logger::warn("Config file not found at {}, creating with defaults", path.string());
             Save();
             return;
         }
 
+        auto settings = Parse(*text);
+        if (!settings) {
+            logger::error("Config file at {} could not be parsed - keeping the current settings", path.string());
+            return;
+        }
+
+        Publish(std::move(*settings));
+        logger::info("Config loaded successfully from {}", path.string());
+    }
+
+    std::optional<std::string> Config::ReadFile(const std::filesystem::path& a_path) {
+        std::ifstream file(a_path, std::ios::binary);
+        if (!file) {
+            return std::nullopt;
+        }
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    std::optional<Config::Snapshot> Config::Parse(const std::string& a_text, bool a_rejectPartial) {
+        CSimpleIniA ini;
+        ini.SetUnicode();
+
+        if (ini.LoadData(a_text) < 0 || (a_rejectPartial && !ini.GetValue("General", "bEnabled", nullptr))) {
+            return std::nullopt;
+        }
+
+        // Parsed into a private copy; nothing is visible to readers until Publish
+        Snapshot settings;
+
         // General settings
-        enabled = ini.GetBoolValue("General", "bEnabled", true);
-        applyToNPCs = ini.GetBoolValue("General", "bApplyToNPCs", false);
-        applySlowdownCastingToNPCsOnly = ini.GetBoolValue("General", "bApplySlowdownCastingToNPCsOnly", false);
-        logLevel = ini.GetLongValue("General", "iLogLevel", 2);
+        settings.enabled = ini.GetBoolValue("General", "bEnabled", true);
+        settings.applyToNPCs = ini.GetBoolValue("General", "bApplyToNPCs", false);
+        settings.applySlowdownCastingToNPCsOnly = ini.GetBoolValue("General", "bApplySlowdownCastingToNPCsOnly", false);
+        settings.logLevel = ini.GetLongValue("General", "iLogLevel", 2);
+        settings.slowdownBackend = ini.GetLongValue("General", "iSlowdownBackend", 0) == 1 ? SlowdownBackend::kSpeedMult : SlowdownBackend::kSpell;
+        settings.binaryTrace = ini.GetBoolValue("General", "bBinaryTrace", false);
+        settings.traceFormat = ini.GetLongValue("General", "iTraceFormat", 0) == 1 ? TraceLog::OutputFormat::kChromeJson : TraceLog::OutputFormat::kBinary;
+        settings.metrics = ini.GetBoolValue("General", "bMetrics", false);
+        settings.stuckSlowdownTimeout = static_cast<float>(ini.GetDoubleValue("General", "fStuckSlowdownTimeout", 120.0));
 
         // Enable/Disable specific debuffs
-        enableBowDebuff = ini.GetBoolValue("General", "bEnableBowDebuff", true);
-        enableCrossbowDebuff = ini.GetBoolValue("General", "bEnableCrossbowDebuff", true);
-        enableCastDebuff = ini.GetBoolValue("General", "bEnableCastDebuff", true);
-        enableDualCastDebuff = ini.GetBoolValue("General", "bEnableDualCastDebuff", true);
+        settings.enableBowDebuff = ini.GetBoolValue("General", "bEnableBowDebuff", true);
+        settings.enableCrossbowDebuff = ini.GetBoolValue("General", "bEnableCrossbowDebuff", true);
+        settings.enableCastDebuff = ini.GetBoolValue("General", "bEnableCastDebuff", true);
+        settings.enableDualCastDebuff = ini.GetBoolValue("General", "bEnableDualCastDebuff", true);
 
         // Bow multipliers
-        bowMultipliers[0] = static_cast<float>(ini.GetDoubleValue("Bow", "fNoviceMultiplier", 0.5));
-        bowMultipliers[1] = static_cast<float>(ini.GetDoubleValue("Bow", "fApprenticeMultiplier", 0.6));
-        bowMultipliers[2] = static_cast<float>(ini.GetDoubleValue("Bow", "fExpertMultiplier", 0.7));
-        bowMultipliers[3] = static_cast<float>(ini.GetDoubleValue("Bow", "fMasterMultiplier", 0.8));
+        settings.bowMultipliers[0] = static_cast<float>(ini.GetDoubleValue("Bow", "fNoviceMultiplier", 0.5));
+        settings.bowMultipliers[1] = static_cast<float>(ini.GetDoubleValue("Bow", "fApprenticeMultiplier", 0.6));
+        settings.bowMultipliers[2] = static_cast<float>(ini.GetDoubleValue("Bow", "fExpertMultiplier", 0.7));
+        settings.bowMultipliers[3] = static_cast<float>(ini.GetDoubleValue("Bow", "fMasterMultiplier", 0.8));
 
         // Crossbow multipliers
-        crossbowMultipliers[0] = static_cast<float>(ini.GetDoubleValue("Crossbow", "fNoviceMultiplier", 0.5));
-        crossbowMultipliers[1] = static_cast<float>(ini.GetDoubleValue("Crossbow", "fApprenticeMultiplier", 0.6));
-        crossbowMultipliers[2] = static_cast<float>(ini.GetDoubleValue("Crossbow", "fExpertMultiplier", 0.7));
-        crossbowMultipliers[3] = static_cast<float>(ini.GetDoubleValue("Crossbow", "fMasterMultiplier", 0.8));
+        settings.crossbowMultipliers[0] = static_cast<float>(ini.GetDoubleValue("Crossbow", "fNoviceMultiplier", 0.5));
+        settings.crossbowMultipliers[1] = static_cast<float>(ini.GetDoubleValue("Crossbow", "fApprenticeMultiplier", 0.6));
+        settings.crossbowMultipliers[2] = static_cast<float>(ini.GetDoubleValue("Crossbow", "fExpertMultiplier", 0.7));
+        settings.crossbowMultipliers[3] = static_cast<float>(ini.GetDoubleValue("Crossbow", "fMasterMultiplier", 0.8));
 
         // Cast multipliers
-        castMultipliers[0] = static_cast<float>(ini.GetDoubleValue("Cast", "fNoviceMultiplier", 0.5));
-        castMultipliers[1] = static_cast<float>(ini.GetDoubleValue("Cast", "fApprenticeMultiplier", 0.6));
-        castMultipliers[2] = static_cast<float>(ini.GetDoubleValue("Cast", "fExpertMultiplier", 0.7));
-        castMultipliers[3] = static_cast<float>(ini.GetDoubleValue("Cast", "fMasterMultiplier", 0.8));
+        settings.castMultipliers[0] = static_cast<float>(ini.GetDoubleValue("Cast", "fNoviceMultiplier", 0.5));
+        settings.castMultipliers[1] = static_cast<float>(ini.GetDoubleValue("Cast", "fApprenticeMultiplier", 0.6));
+        settings.castMultipliers[2] = static_cast<float>(ini.GetDoubleValue("Cast", "fExpertMultiplier", 0.7));
+        settings.castMultipliers[3] = static_cast<float>(ini.GetDoubleValue("Cast", "fMasterMultiplier", 0.8));
 
         // Dual cast multipliers
-        dualCastMultipliers[0] = static_cast<float>(ini.GetDoubleValue("DualCast", "fNoviceMultiplier", 0.4));
-        dualCastMultipliers[1] = static_cast<float>(ini.GetDoubleValue("DualCast", "fApprenticeMultiplier", 0.5));
-        dualCastMultipliers[2] = static_cast<float>(ini.GetDoubleValue("DualCast", "fExpertMultiplier", 0.6));
-        dualCastMultipliers[3] = static_cast<float>(ini.GetDoubleValue("DualCast", "fMasterMultiplier", 0.7));
+        settings.dualCastMultipliers[0] = static_cast<float>(ini.GetDoubleValue("DualCast", "fNoviceMultiplier", 0.4));
+        settings.dualCastMultipliers[1] = static_cast<float>(ini.GetDoubleValue("DualCast", "fApprenticeMultiplier", 0.5));
+        settings.dualCastMultipliers[2] = static_cast<float>(ini.GetDoubleValue("DualCast", "fExpertMultiplier", 0.6));
+        settings.dualCastMultipliers[3] = static_cast<float>(ini.GetDoubleValue("DualCast", "fMasterMultiplier", 0.7));
+
+        // Multipliers outside 0-1 would speed actors up or invert the debuff
+        auto clampMultipliers = [](const char* a_section, std::array<float, 4>& a_multipliers) {
+            for (auto& multiplier : a_multipliers) {
+                if (!(multiplier >= 0.0f && multiplier <= 1.0f)) {
+                    logger::warn("[{}] multiplier {} is outside 0-1 - clamping", a_section, multiplier);
+                    multiplier = std::isnan(multiplier) ? 1.0f : std::clamp(multiplier, 0.0f, 1.0f);
+                }
+            }
+        };
+        clampMultipliers("Bow", settings.bowMultipliers);
+        clampMultipliers("Crossbow", settings.crossbowMultipliers);
+        clampMultipliers("Cast", settings.castMultipliers);
+        clampMultipliers("DualCast", settings.dualCastMultipliers);
+
+        // Skill curves, from the clamped tiers when no points are given
+        auto loadCurve = [&ini](const char* a_section, const std::array<float, 4>& a_multipliers, MagnitudeCurve& a_curve) {
+            const char* shapeText = ini.GetValue(a_section, "sCurve", "tiers");
+            auto shape = MagnitudeCurve::ParseShape(shapeText);
+            if (!shape) {
+                logger::warn("[{}] sCurve '{}' is not tiers, linear or smooth - using tiers", a_section, shapeText);
+            }
+            a_curve.shape = shape.value_or(MagnitudeCurve::Shape::kTiers);
+
+            const char* pointsText = ini.GetValue(a_section, "sCurvePoints", "");
+            auto points = MagnitudeCurve::ParsePoints(pointsText);
+            if (!points && *pointsText) {
+                logger::warn("[{}] sCurvePoints '{}' is not a list of skill:multiplier - using the tiers", a_section, pointsText);
+            }
+            a_curve.points = points ? std::move(*points) : MagnitudeCurve::PointsFromTiers(a_multipliers);
+        };
+        loadCurve("Bow", settings.bowMultipliers, settings.bowCurve);
+        loadCurve("Crossbow", settings.crossbowMultipliers, settings.crossbowCurve);
+        loadCurve("Cast", settings.castMultipliers, settings.castCurve);
+        loadCurve("DualCast", settings.dualCastMultipliers, settings.dualCastCurve);
+
+        settings.logLevel = std::clamp(settings.logLevel, 0, 6);
+        settings.stuckSlowdownTimeout = std::isnan(settings.stuckSlowdownTimeout) ? 120.0f : std::clamp(settings.stuckSlowdownTimeout, 0.0f, 300.0f);
+
+        return settings;
+    }
 
-        logger::info("Config loaded successfully from {}", path.string());
+    const Config::Snapshot* Config::Publish(Snapshot a_snapshot) {
+        a_snapshot.bowTable = a_snapshot.bowCurve.Compile(a_snapshot.bowMultipliers);
+        a_snapshot.crossbowTable = a_snapshot.crossbowCurve.Compile(a_snapshot.crossbowMultipliers);
+        a_snapshot.castTable = a_snapshot.castCurve.Compile(a_snapshot.castMultipliers);
+        a_snapshot.dualCastTable = a_snapshot.dualCastCurve.Compile(a_snapshot.dualCastMultipliers);
+
+        auto snapshot = std::make_unique<const Snapshot>(std::move(a_snapshot));
+        auto result = snapshot.get();
+
+        std::lock_guard<std::mutex> lock(publishLock);
+        published.push_back(std::move(snapshot));
+        current.store(result, std::memory_order_release);
+        return result;
     }
 
-    void Config::Save() {
+    void Config::Save() const {
+        auto config = GetSnapshot();
+
         CSimpleIniA ini;
         ini.SetUnicode();
 
         // General section
         ini.SetValue("General", nullptr, "; SIGA - Slow Motion Combat Plugin");
-        ini.SetBoolValue("General", "bEnabled", enabled);
+        ini.SetBoolValue("General", "bEnabled", config->enabled);
         ini.SetValue("General", nullptr, "; Apply slowdown to NPCs in combat");
-        ini.SetBoolValue("General", "bApplyToNPCs", applyToNPCs);
+        ini.SetBoolValue("General", "bApplyToNPCs", config->applyToNPCs);
         ini.SetValue("General", nullptr, "; Apply casting slowdown to NPCs only (not player)");
-        ini.SetBoolValue("General", "bApplySlowdownCastingToNPCsOnly", applySlowdownCastingToNPCsOnly);
+        ini.SetBoolValue("General", "bApplySlowdownCastingToNPCsOnly", config->applySlowdownCastingToNPCsOnly);
         ini.SetValue("General", nullptr, "; Log level: 0=trace, 1=debug, 2=info, 3=warn, 4=error, 5=critical");
-        ini.SetLongValue("General", "iLogLevel", logLevel);
+        ini.SetLongValue("General", "iLogLevel", config->logLevel);
+        ini.SetValue("General", nullptr, "; Slowdown backend: 0=debuff spells, 1=direct SpeedMult modifier (no magic effects)");
+        ini.SetLongValue("General", "iSlowdownBackend", static_cast<long>(config->slowdownBackend));
+        ini.SetValue("General", nullptr, "; Record every slowdown event to a trace file next to the log, at a few ns each");
+        ini.SetBoolValue("General", "bBinaryTrace", config->binaryTrace);
+        ini.SetValue("General", nullptr, "; Trace file: 0=SigaNG.trace (read it with siga_trace_decode), 1=SigaNG.json timeline for chrome://tracing or Perfetto");
+        ini.SetLongValue("General", "iTraceFormat", static_cast<long>(config->traceFormat));
+        ini.SetValue("General", nullptr, "; Write event counts and slowdown latencies to SigaNG.stats every 10 seconds");
+        ini.SetBoolValue("General", "bMetrics", config->metrics);
+        ini.SetValue("General", nullptr, "; Seconds a slowed actor may go without a cast or draw event before its slowdown is treated as stuck and cleared, 0-300; 0 = never");
+        ini.SetValue("General", nullptr, "; A held draw or a concentration cast sends no events, so a short timeout cuts those slowdowns off; a long one leaves a truly stuck slowdown in place longer");
+        ini.SetDoubleValue("General", "fStuckSlowdownTimeout", config->stuckSlowdownTimeout);
 
         ini.SetValue("General", nullptr, "; Enable/Disable specific slowdown types");
-        ini.SetBoolValue("General", "bEnableBowDebuff", enableBowDebuff);
-        ini.SetBoolValue("General", "bEnableCrossbowDebuff", enableCrossbowDebuff);
-        ini.SetBoolValue("General", "bEnableCastDebuff", enableCastDebuff);
-        ini.SetBoolValue("General", "bEnableDualCastDebuff", enableDualCastDebuff);
+        ini.SetBoolValue("General", "bEnableBowDebuff", config->enableBowDebuff);
+        ini.SetBoolValue("General", "bEnableCrossbowDebuff", config->enableCrossbowDebuff);
+        ini.SetBoolValue("General", "bEnableCastDebuff", config->enableCastDebuff);
+        ini.SetBoolValue("General", "bEnableDualCastDebuff", config->enableDualCastDebuff);
 
         // Bow section
         ini.SetValue("Bow", nullptr, "; Bow slowdown multipliers by skill level");
-        ini.SetDoubleValue("Bow", "fNoviceMultiplier", bowMultipliers[0]);
-        ini.SetDoubleValue("Bow", "fApprenticeMultiplier", bowMultipliers[1]);
-        ini.SetDoubleValue("Bow", "fExpertMultiplier", bowMultipliers[2]);
-        ini.SetDoubleValue("Bow", "fMasterMultiplier", bowMultipliers[3]);
+        ini.SetDoubleValue("Bow", "fNoviceMultiplier", config->bowMultipliers[0]);
+        ini.SetDoubleValue("Bow", "fApprenticeMultiplier", config->bowMultipliers[1]);
+        ini.SetDoubleValue("Bow", "fExpertMultiplier", config->bowMultipliers[2]);
+        ini.SetDoubleValue("Bow", "fMasterMultiplier", config->bowMultipliers[3]);
 
         // Crossbow section
         ini.SetValue("Crossbow", nullptr, "; Crossbow slowdown multipliers by skill level");
-        ini.SetDoubleValue("Crossbow", "fNoviceMultiplier", crossbowMultipliers[0]);
-        ini.SetDoubleValue("Crossbow", "fApprenticeMultiplier", crossbowMultipliers[1]);
-        ini.SetDoubleValue("Crossbow", "fExpertMultiplier", crossbowMultipliers[2]);
-        ini.SetDoubleValue("Crossbow", "fMasterMultiplier", crossbowMultipliers[3]);
+        ini.SetDoubleValue("Crossbow", "fNoviceMultiplier", config->crossbowMultipliers[0]);
+        ini.SetDoubleValue("Crossbow", "fApprenticeMultiplier", config->crossbowMultipliers[1]);
+        ini.SetDoubleValue("Crossbow", "fExpertMultiplier", config->crossbowMultipliers[2]);
+        ini.SetDoubleValue("Crossbow", "fMasterMultiplier", config->crossbowMultipliers[3]);
 
         // Cast section
         ini.SetValue("Cast", nullptr, "; Magic casting slowdown multipliers by skill level");
-        ini.SetDoubleValue("Cast", "fNoviceMultiplier", castMultipliers[0]);
-        ini.SetDoubleValue("Cast", "fApprenticeMultiplier", castMultipliers[1]);
-        ini.SetDoubleValue("Cast", "fExpertMultiplier", castMultipliers[2]);
-        ini.SetDoubleValue("Cast", "fMasterMultiplier", castMultipliers[3]);
+        ini.SetDoubleValue("Cast", "fNoviceMultiplier", config->castMultipliers[0]);
+        ini.SetDoubleValue("Cast", "fApprenticeMultiplier", config->castMultipliers[1]);
+        ini.SetDoubleValue("Cast", "fExpertMultiplier", config->castMultipliers[2]);
+        ini.SetDoubleValue("Cast", "fMasterMultiplier", config->castMultipliers[3]);
 
         // Dual cast section
         ini.SetValue("DualCast", nullptr, "; Dual casting slowdown multipliers by skill level");
-        ini.SetDoubleValue("DualCast", "fNoviceMultiplier", dualCastMultipliers[0]);
-        ini.SetDoubleValue("DualCast", "fApprenticeMultiplier", dualCastMultipliers[1]);
-        ini.SetDoubleValue("DualCast", "fExpertMultiplier", dualCastMultipliers[2]);
-        ini.SetDoubleValue("DualCast", "fMasterMultiplier", dualCastMultipliers[3]);
+        ini.SetDoubleValue("DualCast", "fNoviceMultiplier", config->dualCastMultipliers[0]);
+        ini.SetDoubleValue("DualCast", "fApprenticeMultiplier", config->dualCastMultipliers[1]);
+        ini.SetDoubleValue("DualCast", "fExpertMultiplier", config->dualCastMultipliers[2]);
+        ini.SetDoubleValue("DualCast", "fMasterMultiplier", config->dualCastMultipliers[3]);
+
+        // Skill curves, in each type's section
+        auto saveCurve = [&ini](const char* a_section, const std::array<float, 4>& a_multipliers, const MagnitudeCurve& a_curve) {
+            auto points = a_curve.points.empty() ? MagnitudeCurve::PointsFromTiers(a_multipliers) : a_curve.points;
+            ini.SetValue(a_section, "sCurve", MagnitudeCurve::ShapeName(a_curve.shape),
+                "; Skill curve: tiers (the four multipliers above), linear or smooth (through sCurvePoints)");
+            ini.SetValue(a_section, "sCurvePoints", MagnitudeCurve::FormatPoints(points).c_str(),
+                "; skill:multiplier points for linear and smooth curves");
+        };
+        saveCurve("Bow", config->bowMultipliers, config->bowCurve);
+        saveCurve("Crossbow", config->crossbowMultipliers, config->crossbowCurve);
+        saveCurve("Cast", config->castMultipliers, config->castCurve);
+        saveCurve("DualCast", config->dualCastMultipliers, config->dualCastCurve);
 
         auto path = GetConfigPath();
         std::filesystem::create_directories(path.parent_path());
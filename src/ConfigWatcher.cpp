@@ -0,0 +1,128 @@
+#include "SIGA/ConfigWatcher.h"
+#include "SIGA/Config.h"
+#include "SIGA/Metrics.h"
+#include "SIGA/SlowMotion.h"
+#include "SIGA/TraceLog.h"
+
+namespace SIGA {
+    void ConfigWatcher::Start(std::filesystem::path a_path, std::chrono::milliseconds a_interval) {
+        Stop();
+
+        path = std::move(a_path);
+        interval = a_interval;
+        loadedStamp = StampOf(path);
+        changedStamp.reset();
+        auto text = Config::ReadFile(path);
+        loadedHash = text ? HashOf(*text) : 0;
+
+        if (interval.count() > 0) {
+            thread = std::jthread([this](std::stop_token a_stop) { Run(a_stop); });
+        }
+        logger::info("Watching {} for changes", path.string());
+    }
+
+    void ConfigWatcher::Stop() {
+        if (thread.joinable()) {
+            thread.request_stop();
+            thread.join();
+        }
+    }
+
+    void ConfigWatcher::Run(std::stop_token a_stop) {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!a_stop.stop_requested()) {
+            // Returns early when Stop() is requested
+            wake.wait_for(lock, a_stop, interval, [] { return false; });
+            if (!a_stop.stop_requested()) {
+                Poll();
+            }
+        }
+    }
+
+    bool ConfigWatcher::Poll() {
+        auto stamp = StampOf(path);
+        if (!stamp || stamp == loadedStamp) {
+            changedStamp.reset();
+            return false;
+        }
+        if (stamp != changedStamp) {
+            // Editors often save in several writes; wait until the file holds still
+            changedStamp = stamp;
+            return false;
+        }
+
+        loadedStamp = stamp;
+        changedStamp.reset();
+
+        auto text = Config::ReadFile(path);
+        if (!text) {
+            return false;
+        }
+        auto hash = HashOf(*text);
+        if (hash == loadedHash) {
+            // Touched or saved without edits
+            return false;
+        }
+        loadedHash = hash;
+
+        // A file caught half-written by an editor may lack its sections; keep the current
+        // settings rather than fall back to defaults for everything missing
+        TraceLog::ScopedSpan span(Trace::Span::kConfigLoad);
+        auto settings = Config::Parse(*text, true);
+        if (!settings) {
+            logger::warn("{} changed but could not be parsed - keeping the current settings", path.string());
+            return false;
+        }
+
+        auto config = Config::GetSingleton();
+        auto previous = config->GetSnapshot();
+        if (settings->pluginName != previous->pluginName || settings->bowDebuffSpellID != previous->bowDebuffSpellID ||
+            settings->castingDebuffSpellID != previous->castingDebuffSpellID ||
+            settings->dualCastDebuffSpellID != previous->dualCastDebuffSpellID ||
+            settings->crossbowDebuffSpellID != previous->crossbowDebuffSpellID) {
+            logger::warn("Debuff plugin or spell IDs changed in {} - they take effect after a restart", path.string());
+        }
+        auto current = config->Publish(std::move(*settings));
+        reloadCount.fetch_add(1, std::memory_order_relaxed);
+        logger::info("Config reloaded from {}", path.string());
+
+        // New events read the new snapshot right away; slowdowns already applied are the
+        // main thread's to change
+        auto apply = [previous, current]() {
+            spdlog::set_level(static_cast<spdlog::level::level_enum>(current->logLevel));
+            TraceLog::GetSingleton()->SetEnabled(current->binaryTrace);
+            Metrics::GetSingleton()->SetEnabled(current->metrics);
+            SlowMotionManager::GetSingleton()->ApplyConfigChange(*previous, *current);
+        };
+        if (auto taskInterface = SKSE::GetTaskInterface()) {
+            taskInterface->AddTask(apply);
+        }
+        else {
+            apply();
+        }
+        return true;
+    }
+
+    std::optional<ConfigWatcher::FileStamp> ConfigWatcher::StampOf(const std::filesystem::path& a_path) {
+        std::error_code error;
+        auto writeTime = std::filesystem::last_write_time(a_path, error);
+        if (error) {
+            return std::nullopt;
+        }
+        auto size = std::filesystem::file_size(a_path, error);
+        if (error) {
+            return std::nullopt;
+        }
+        return FileStamp{ writeTime, size };
+    }
+
+    std::uint64_t ConfigWatcher::HashOf(const std::string& a_text) {
+        // FNV-1a: the file is a few kilobytes and read once per change
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (auto c : a_text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+}
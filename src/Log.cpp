@@ -0,0 +1,12 @@
+#include "SIGA/Log.h"
+
+#include <spdlog/async.h>
+
+namespace SIGA::Log {
+    std::shared_ptr<spdlog::logger> MakeAsyncLogger(std::string a_name, spdlog::sink_ptr a_sink) {
+        // An async logger only holds its pool weakly; this one lives as long as the process
+        static auto pool = std::make_shared<spdlog::details::thread_pool>(QUEUE_SIZE, 1);
+        return std::make_shared<spdlog::async_logger>(std::move(a_name), std::move(a_sink), pool,
+            spdlog::async_overflow_policy::overrun_oldest);
+    }
+}
@@ -0,0 +1,181 @@
+#include "SIGA/MagnitudeCurve.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+namespace SIGA {
+    namespace {
+        std::string_view Trim(std::string_view a_text) {
+            auto begin = a_text.find_first_not_of(" \t");
+            if (begin == std::string_view::npos) return {};
+            auto end = a_text.find_last_not_of(" \t");
+            return a_text.substr(begin, end - begin + 1);
+        }
+
+        std::optional<float> ParseFloat(std::string_view a_text) {
+            a_text = Trim(a_text);
+            float value = 0.0f;
+            auto [ptr, ec] = std::from_chars(a_text.data(), a_text.data() + a_text.size(), value);
+            if (ec != std::errc{} || ptr != a_text.data() + a_text.size() || !std::isfinite(value)) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        // Fritsch-Carlson tangents: a cubic Hermite through the points that stays monotone
+        // wherever the points are, so a curve never dips below or above its neighbours
+        std::vector<float> MonotoneTangents(const std::vector<MagnitudeCurve::Point>& a_points) {
+            auto count = a_points.size();
+            std::vector<float> secants(count - 1);
+            for (std::size_t i = 0; i + 1 < count; ++i) {
+                secants[i] = (a_points[i + 1].multiplier - a_points[i].multiplier) / (a_points[i + 1].skill - a_points[i].skill);
+            }
+
+            std::vector<float> tangents(count);
+            tangents.front() = secants.front();
+            tangents.back() = secants.back();
+            for (std::size_t i = 1; i + 1 < count; ++i) {
+                tangents[i] = secants[i - 1] * secants[i] > 0.0f ? (secants[i - 1] + secants[i]) * 0.5f : 0.0f;
+            }
+
+            for (std::size_t i = 0; i + 1 < count; ++i) {
+                if (secants[i] == 0.0f) {
+                    tangents[i] = 0.0f;
+                    tangents[i + 1] = 0.0f;
+                    continue;
+                }
+                auto a = tangents[i] / secants[i];
+                auto b = tangents[i + 1] / secants[i];
+                auto length = a * a + b * b;
+                if (length > 9.0f) {
+                    auto scale = 3.0f / std::sqrt(length);
+                    tangents[i] = scale * a * secants[i];
+                    tangents[i + 1] = scale * b * secants[i];
+                }
+            }
+            return tangents;
+        }
+    }
+
+    std::uint32_t MagnitudeCurve::TierFor(float a_skill) {
+        if (a_skill <= 25) return 0;
+        if (a_skill <= 50) return 1;
+        if (a_skill <= 75) return 2;
+        return 3;
+    }
+
+    float MagnitudeCurve::Evaluate(float a_skill, const std::array<float, 4>& a_tierMultipliers) const {
+        if (shape == Shape::kTiers || points.empty()) {
+            return a_tierMultipliers[TierFor(a_skill)];
+        }
+
+        // Flat beyond the first and last points
+        if (a_skill <= points.front().skill) return points.front().multiplier;
+        if (a_skill >= points.back().skill) return points.back().multiplier;
+
+        auto upper = std::upper_bound(points.begin(), points.end(), a_skill,
+            [](float a_value, const Point& a_point) { return a_value < a_point.skill; });
+        auto index = static_cast<std::size_t>(upper - points.begin()) - 1;
+        auto& p0 = points[index];
+        auto& p1 = points[index + 1];
+        auto h = p1.skill - p0.skill;
+        auto t = (a_skill - p0.skill) / h;
+
+        if (shape == Shape::kLinear) {
+            return p0.multiplier + (p1.multiplier - p0.multiplier) * t;
+        }
+
+        // Only evaluated while building lookup tables, so the tangents are not cached
+        auto tangents = MonotoneTangents(points);
+        auto t2 = t * t;
+        auto t3 = t2 * t;
+        return (2 * t3 - 3 * t2 + 1) * p0.multiplier +
+               (t3 - 2 * t2 + t) * h * tangents[index] +
+               (-2 * t3 + 3 * t2) * p1.multiplier +
+               (t3 - t2) * h * tangents[index + 1];
+    }
+
+    MagnitudeTable MagnitudeCurve::Compile(const std::array<float, 4>& a_tierMultipliers) const {
+        MagnitudeTable table{};
+        for (std::uint32_t skill = 0; skill <= MAX_TABLE_SKILL; ++skill) {
+            auto level = static_cast<float>(skill);
+            table[skill] = { MagnitudeFromMultiplier(Evaluate(level, a_tierMultipliers)), TierFor(level) };
+        }
+        return table;
+    }
+
+    std::uint32_t MagnitudeCurve::SkillIndex(float a_skill) {
+        if (!(a_skill > 0.0f)) return 0;
+        if (a_skill >= static_cast<float>(MAX_TABLE_SKILL)) return MAX_TABLE_SKILL;
+        return static_cast<std::uint32_t>(std::ceil(a_skill));
+    }
+
+    std::vector<MagnitudeCurve::Point> MagnitudeCurve::PointsFromTiers(const std::array<float, 4>& a_tierMultipliers) {
+        return {
+            { 25.0f, a_tierMultipliers[0] },
+            { 50.0f, a_tierMultipliers[1] },
+            { 75.0f, a_tierMultipliers[2] },
+            { 100.0f, a_tierMultipliers[3] },
+        };
+    }
+
+    std::optional<std::vector<MagnitudeCurve::Point>> MagnitudeCurve::ParsePoints(std::string_view a_text) {
+        std::vector<Point> result;
+        while (!Trim(a_text).empty()) {
+            auto comma = a_text.find(',');
+            auto item = a_text.substr(0, comma);
+            a_text = comma == std::string_view::npos ? std::string_view{} : a_text.substr(comma + 1);
+
+            auto colon = item.find(':');
+            if (colon == std::string_view::npos) {
+                return std::nullopt;
+            }
+            auto skill = ParseFloat(item.substr(0, colon));
+            auto multiplier = ParseFloat(item.substr(colon + 1));
+            if (!skill || !multiplier || *skill < 0.0f || *multiplier < 0.0f || *multiplier > 1.0f) {
+                return std::nullopt;
+            }
+            result.push_back({ *skill, *multiplier });
+        }
+
+        std::sort(result.begin(), result.end(), [](const Point& a, const Point& b) { return a.skill < b.skill; });
+        auto duplicate = std::adjacent_find(result.begin(), result.end(), [](const Point& a, const Point& b) { return a.skill == b.skill; });
+        if (result.empty() || duplicate != result.end()) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    std::string MagnitudeCurve::FormatPoints(const std::vector<Point>& a_points) {
+        std::string result;
+        for (auto& point : a_points) {
+            if (!result.empty()) {
+                result += ", ";
+            }
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%g:%g", point.skill, point.multiplier);
+            result += buffer;
+        }
+        return result;
+    }
+
+    std::optional<MagnitudeCurve::Shape> MagnitudeCurve::ParseShape(std::string_view a_text) {
+        a_text = Trim(a_text);
+        if (a_text == "tiers") return Shape::kTiers;
+        if (a_text == "linear") return Shape::kLinear;
+        if (a_text == "smooth") return Shape::kSmooth;
+        return std::nullopt;
+    }
+
+    const char* MagnitudeCurve::ShapeName(Shape a_shape) {
+        switch (a_shape) {
+        case Shape::kLinear:
+            return "linear";
+        case Shape::kSmooth:
+            return "smooth";
+        default:
+            return "tiers";
+        }
+    }
+}
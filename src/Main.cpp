@@ -2,8 +2,17 @@
 #include "SIGA/AnimationHandler.h"
 #include "SIGA/CombatEventHandler.h"  
 #include "SIGA/SlowMotion.h"
+#include "SIGA/SpellIndex.h"
 #include "SIGA/Config.h"
-#include <atomic>
+#include "SIGA/ConfigWatcher.h"
+#include "SIGA/TagClassifier.h"
+#include "SIGA/Log.h"
+#include "SIGA/Metrics.h"
+#include "SIGA/PlayerGraphHandler.h"
+#include "SIGA/SkillCache.h"
+#include "SIGA/SlowdownTimers.h"
+#include "SIGA/TraceLog.h"
+#include "SIGA/WeaponCache.h"
 
 using namespace SKSE;
 using namespace SKSE::log;
@@ -33,124 +42,130 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Query(const SKSE::QueryInterface*,
 }
 
 namespace {
-    std::atomic<bool> g_registered = false;
-    std::atomic<bool> g_gameLoaded = false;
-
-    class InputEventHandler : public RE::BSTEventSink<RE::InputEvent*> {
-    public:
-        static InputEventHandler* GetSingleton() {
-            static InputEventHandler singleton;
-            return &singleton;
-        }
-
-        virtual RE::BSEventNotifyControl ProcessEvent(
-            RE::InputEvent* const* a_event,
-            RE::BSTEventSource<RE::InputEvent*>* a_eventSource) override
-        {
-
-            if (g_registered.load()) {
-                return RE::BSEventNotifyControl::kContinue;
-            }
-
-
-            if (!g_gameLoaded.load()) {
-                return RE::BSEventNotifyControl::kContinue;
-            }
-
-            if (!a_event) {
-                return RE::BSEventNotifyControl::kContinue;
-            }
-
-
-            if (g_registered.exchange(true)) {
-                return RE::BSEventNotifyControl::kContinue;
-            }
-
-
-            auto player = RE::PlayerCharacter::GetSingleton();
-            if (player) {
-                bool result = player->AddAnimationGraphEventSink(SIGA::AnimationEventHandler::GetSingleton());
-                if (result) {
-                    logger::debug("Animation events registered for player");
-
-                }
-                else {
-
-                    g_registered.store(false);
-                }
-            }
-            else {
-
-                g_registered.store(false);
-            }
-
-            return RE::BSEventNotifyControl::kContinue;
-        }
-
-    private:
-        InputEventHandler() = default;
-        InputEventHandler(const InputEventHandler&) = delete;
-        InputEventHandler(InputEventHandler&&) = delete;
-    };
-
     void InitializeLog() {
         auto path = log_directory();
         if (!path) return;
 
         *path /= "SigaNG.log";
         auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
-        auto log = std::make_shared<spdlog::logger>("global log", std::move(sink));
+        auto log = SIGA::Log::MakeAsyncLogger("global log", std::move(sink));
 
+        // Writes happen on the logger's thread; warnings reach the file right away, the
+        // rest within a second
         log->set_level(spdlog::level::info);
-        log->flush_on(spdlog::level::info);
+        log->flush_on(spdlog::level::warn);
 
         spdlog::set_default_logger(std::move(log));
         spdlog::set_pattern("[%H:%M:%S] [%l] %v");
+        spdlog::flush_every(std::chrono::seconds(1));
     }
 
     void MessageHandler(SKSE::MessagingInterface::Message* a_msg) {
         switch (a_msg->type) {
         case SKSE::MessagingInterface::kDataLoaded:
         {
-            logger::debug("kDataLoaded message received");
+            SIGA_LOG_DEBUG("kDataLoaded message received");
 
             // Initialize spell manager
             if (!SIGA::SlowMotionManager::GetSingleton()->Initialize()) {
                 logger::error("Failed to initialize SlowMotionManager - debuff spells not loaded!");
             }
 
-            // Register input event handler for player
-            if (auto inputManager = RE::BSInputDeviceManager::GetSingleton()) {
-                inputManager->AddEventSink(InputEventHandler::GetSingleton());
-                logger::debug("Input event handler registered");
-            }
-            else {
-                logger::error("Failed to get input device manager");
+            // Resolve animation tags to their interned strings
+            SIGA::TagClassifier::GetSingleton()->Initialize();
+
+            // Index every spell's school and SpeedMult effects in the background; casts walk
+            // the spell's effects until it is ready
+            SIGA::SpellIndex::GetSingleton()->BuildAsync();
+
+            // Trace and metrics, if SIGA.ini asks for them; a reload can switch them on later
+            auto config = SIGA::Config::GetSingleton()->GetSnapshot();
+            if (auto path = logger::log_directory()) {
+                bool chrome = config->traceFormat == SIGA::TraceLog::OutputFormat::kChromeJson;
+                SIGA::TraceLog::GetSingleton()->SetOutput(*path / (chrome ? "SigaNG.json" : "SigaNG.trace"), config->traceFormat);
+                SIGA::Metrics::GetSingleton()->SetOutput(*path / "SigaNG.stats");
             }
+            SIGA::TraceLog::GetSingleton()->SetEnabled(config->binaryTrace);
+            SIGA::Metrics::GetSingleton()->SetEnabled(config->metrics);
+
+            // Pick up SIGA.ini edits without restarting the game
+            SIGA::ConfigWatcher::GetSingleton()->Start(SIGA::Config::GetConfigPath());
 
-            // Register combat event handler for NPCs
+            // Clears slowdowns whose release event never arrived, for the player and NPCs
+            SIGA::SlowdownTimers::GetSingleton()->Start();
+
+            // Register combat event handler for NPCs; death and unload events take their
+            // animation sinks off again
             if (auto scriptEventSource = RE::ScriptEventSourceHolder::GetSingleton()) {
-                scriptEventSource->AddEventSink(SIGA::CombatEventHandler::GetSingleton());
-                logger::debug("Combat event handler registered for NPC tracking");
+                auto combatHandler = SIGA::CombatEventHandler::GetSingleton();
+                scriptEventSource->AddEventSink<RE::TESCombatEvent>(combatHandler);
+                scriptEventSource->AddEventSink<RE::TESDeathEvent>(combatHandler);
+                scriptEventSource->AddEventSink<RE::TESCellAttachDetachEvent>(combatHandler);
+                SIGA_LOG_DEBUG("Combat event handler registered for NPC tracking");
+
+                // Re-attaches the player's sink whenever their animation graph is rebuilt
+                auto playerHandler = SIGA::PlayerGraphHandler::GetSingleton();
+                scriptEventSource->AddEventSink<RE::TESObjectLoadedEvent>(playerHandler);
+                scriptEventSource->AddEventSink<RE::TESSwitchRaceCompleteEvent>(playerHandler);
+
+                // Keeps each tracked actor's bow/crossbow current without engine queries on draw
+                scriptEventSource->AddEventSink<RE::TESEquipEvent>(SIGA::WeaponCache::GetSingleton());
+                // Fortify gear and potions make cached skills stale
+                scriptEventSource->AddEventSink<RE::TESEquipEvent>(SIGA::SkillCache::GetSingleton());
             }
             else {
                 logger::error("Failed to get script event source");
             }
 
+            // Skill and level increases make cached skills stale, as do equips (above)
+            if (auto skillIncreases = RE::SkillIncrease::GetEventSource()) {
+                skillIncreases->AddEventSink(SIGA::SkillCache::GetSingleton());
+            }
+            if (auto levelIncreases = RE::LevelIncrease::GetEventSource()) {
+                levelIncreases->AddEventSink(SIGA::SkillCache::GetSingleton());
+            }
+
             break;
         }
 
-        case SKSE::MessagingInterface::kPostLoadGame:
-        case SKSE::MessagingInterface::kNewGame:
+        case SKSE::MessagingInterface::kSaveGame:
         {
-            logger::debug("kPostLoadGame/kNewGame message received");
-
-
-            g_registered.store(false);
-            g_gameLoaded.store(true);
+            // SpeedMult modifiers are written into the save; take ours off first so a
+            // slowdown active at save time is not baked into the actor
+            auto slowMgr = SIGA::SlowMotionManager::GetSingleton();
+            if (slowMgr->GetBackend() == SIGA::Config::SlowdownBackend::kSpeedMult) {
+                slowMgr->ClearAll();
+            }
+            break;
+        }
 
+        case SKSE::MessagingInterface::kPreLoadGame:
+        {
+            // The old game's actors still exist; take our slowdowns off them through the
+            // active backend before the load reuses their handles
             SIGA::SlowMotionManager::GetSingleton()->ClearAll();
-            logger::debug("Ready - animation events will register on first player input");
+            break;
+        }
+
+        case SKSE::MessagingInterface::kPostLoadGame:
+        case SKSE::MessagingInterface::kNewGame:
+        {
+            SIGA_LOG_DEBUG("kPostLoadGame/kNewGame message received");
+
+            SIGA::TagClassifier::GetSingleton()->LogStats();
+            SIGA::SlowMotionManager::GetSingleton()->LogCoalescingStats();
+
+            // Events queued before the load name actors from the old game. Their slowdowns
+            // came off at kPreLoadGame, so whatever is tracked now goes without engine calls.
+            SIGA::AnimationEventHandler::GetSingleton()->DiscardQueued();
+            SIGA::SlowMotionManager::GetSingleton()->ForgetAll();
+            SIGA::SlowdownTimers::GetSingleton()->Clear();
+            SIGA::WeaponCache::GetSingleton()->Clear();
+            SIGA::SkillCache::GetSingleton()->Clear();
+            SIGA::CombatEventHandler::GetSingleton()->Clear();
+
+            // If the player's 3D is not loaded yet, its TESObjectLoadedEvent registers instead
+            SIGA::PlayerGraphHandler::GetSingleton()->Register();
             break;
         }
         }
@@ -163,7 +178,7 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
 
     // Load config early to set log level
     SIGA::Config::GetSingleton()->Load();
-    spdlog::set_level(static_cast<spdlog::level::level_enum>(SIGA::Config::GetSingleton()->logLevel));
+    spdlog::set_level(static_cast<spdlog::level::level_enum>(SIGA::Config::GetSingleton()->GetSnapshot()->logLevel));
 
     logger::info("{} v{} loading...", PLUGIN_NAME, PLUGIN_VERSION.string());
 
@@ -0,0 +1,272 @@
+#include "SIGA/Metrics.h"
+
+#include <bit>
+#include <cstdio>
+
+namespace SIGA {
+    namespace {
+        thread_local void* threadMetrics = nullptr;
+    }
+
+    Metrics::~Metrics() {
+        if (dumper.joinable()) {
+            dumper.request_stop();
+            dumper.join();
+        }
+    }
+
+    void Metrics::SetOutput(std::filesystem::path a_path) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        path = std::move(a_path);
+    }
+
+    void Metrics::SetEnabled(bool a_enabled) {
+        if (a_enabled && startTicks == 0) {
+            startTicks = ReadTicks();
+            startTime = std::chrono::steady_clock::now();
+        }
+        if (enabled.exchange(a_enabled) == a_enabled) {
+            return;
+        }
+        if (a_enabled) {
+            if (!dumper.joinable()) {
+                dumper = std::jthread([this](std::stop_token a_stop) { Run(a_stop); });
+            }
+            logger::info("Metrics enabled");
+        }
+        else {
+            // The file keeps the totals up to this point
+            Dump();
+            logger::info("Metrics disabled");
+        }
+    }
+
+    Metrics::ThreadMetrics& Metrics::Local() {
+        auto local = static_cast<ThreadMetrics*>(threadMetrics);
+        if (!local) {
+            local = &RegisterThread();
+            threadMetrics = local;
+        }
+        return *local;
+    }
+
+    Metrics::ThreadMetrics& Metrics::RegisterThread() {
+        auto block = std::make_unique<ThreadMetrics>();
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        threads.push_back(std::move(block));
+        return *threads.back();
+    }
+
+    std::uint32_t Metrics::BucketOf(std::uint64_t a_ticks) {
+        return std::min<std::uint32_t>(static_cast<std::uint32_t>(std::bit_width(a_ticks)), HISTOGRAM_BUCKETS - 1);
+    }
+
+    void Metrics::Record(Histogram a_histogram, std::uint64_t a_ticks) {
+        Bump(Local().histograms[static_cast<std::size_t>(a_histogram)][BucketOf(a_ticks)]);
+    }
+
+    void Metrics::RecordWait(Lock a_lock, std::uint64_t a_ticks) {
+        Bump(Local().lockWaits[static_cast<std::size_t>(a_lock)][BucketOf(a_ticks)]);
+    }
+
+    void Metrics::RecordHold(Lock a_lock, std::uint64_t a_ticks) {
+        Bump(Local().lockHolds[static_cast<std::size_t>(a_lock)][BucketOf(a_ticks)]);
+    }
+
+    Metrics::Snapshot Metrics::Collect() const {
+        Snapshot result;
+        {
+            std::lock_guard<std::mutex> lock(threadsMutex);
+            for (auto& block : threads) {
+                for (std::size_t i = 0; i < result.counters.size(); ++i) {
+                    result.counters[i] += block->counters[i].load(std::memory_order_relaxed);
+                }
+                for (std::size_t i = 0; i < result.events.size(); ++i) {
+                    result.events[i] += block->events[i].load(std::memory_order_relaxed);
+                }
+                for (std::size_t h = 0; h < result.histograms.size(); ++h) {
+                    for (std::uint32_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+                        result.histograms[h][b] += block->histograms[h][b].load(std::memory_order_relaxed);
+                    }
+                }
+                for (std::size_t l = 0; l < result.lockWaits.size(); ++l) {
+                    for (std::uint32_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+                        result.lockWaits[l][b] += block->lockWaits[l][b].load(std::memory_order_relaxed);
+                        result.lockHolds[l][b] += block->lockHolds[l][b].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+
+        auto ticks = ReadTicks() - startTicks;
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+        if (startTicks != 0 && ticks > 0) {
+            result.nsPerTick = elapsed / static_cast<double>(ticks);
+        }
+        return result;
+    }
+
+    void Metrics::Reset() {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        for (auto& block : threads) {
+            for (auto& counter : block->counters) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+            for (auto& counter : block->events) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+            for (auto& histogram : block->histograms) {
+                for (auto& bucket : histogram) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+            for (std::size_t l = 0; l < block->lockWaits.size(); ++l) {
+                for (std::uint32_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+                    block->lockWaits[l][b].store(0, std::memory_order_relaxed);
+                    block->lockHolds[l][b].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    std::uint64_t Metrics::Percentile(const std::array<std::uint64_t, HISTOGRAM_BUCKETS>& a_buckets, double a_percentile) {
+        std::uint64_t total = 0;
+        for (auto count : a_buckets) {
+            total += count;
+        }
+        if (total == 0) {
+            return 0;
+        }
+
+        auto rank = static_cast<std::uint64_t>(a_percentile * static_cast<double>(total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::uint32_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            seen += a_buckets[b];
+            if (seen >= rank) {
+                return std::uint64_t{ 1 } << b;
+            }
+        }
+        return std::uint64_t{ 1 } << (HISTOGRAM_BUCKETS - 1);
+    }
+
+    void Metrics::Dump() const {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (path.empty()) {
+            return;
+        }
+
+        auto stats = Collect();
+        auto file = std::fopen(path.string().c_str(), "w");
+        if (!file) {
+            return;
+        }
+
+        std::fprintf(file, "[Events]\n");
+        std::fprintf(file, "%-24s %14llu\n", CounterName(Counter::kProcessEvent),
+            static_cast<unsigned long long>(stats.counters[static_cast<std::size_t>(Counter::kProcessEvent)]));
+        for (std::size_t i = 0; i < stats.events.size(); ++i) {
+            auto name = AnimEventTags::NameOf(static_cast<AnimEventType>(i));
+            std::fprintf(file, "%-24.*s %14llu\n", static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(stats.events[i]));
+        }
+
+        std::fprintf(file, "\n[Rejections and engine calls]\n");
+        for (std::size_t i = 1; i < stats.counters.size(); ++i) {
+            std::fprintf(file, "%-24s %14llu\n", CounterName(static_cast<Counter>(i)), static_cast<unsigned long long>(stats.counters[i]));
+        }
+
+        // Bucket bounds are powers of two in ticks, so each figure is an upper bound
+        std::fprintf(file, "\n[Latency, ns]\n%-24s %14s %10s %10s %10s %10s\n", "", "count", "p50", "p90", "p99", "max");
+        for (std::size_t h = 0; h < stats.histograms.size(); ++h) {
+            auto& buckets = stats.histograms[h];
+            std::uint64_t count = 0;
+            for (auto bucket : buckets) {
+                count += bucket;
+            }
+            auto ns = [&](std::uint64_t a_ticks) { return static_cast<double>(a_ticks) * stats.nsPerTick; };
+            std::fprintf(file, "%-24s %14llu %10.0f %10.0f %10.0f %10.0f\n", HistogramName(static_cast<Histogram>(h)),
+                static_cast<unsigned long long>(count), ns(Percentile(buckets, 0.5)), ns(Percentile(buckets, 0.9)),
+                ns(Percentile(buckets, 0.99)), ns(Percentile(buckets, 1.0)));
+        }
+
+        // Waits are taken over the contended acquires only; the rest waited for nothing
+        std::fprintf(file, "\n[Locks, ns]\n%-24s %14s %10s %10s %10s %10s %10s\n", "", "acquired", "contended", "wait p50",
+            "wait max", "hold p50", "hold max");
+        for (std::size_t l = 0; l < stats.lockWaits.size(); ++l) {
+            auto waits = stats.lockWaits[l];
+            std::uint64_t acquired = 0;
+            for (auto bucket : waits) {
+                acquired += bucket;
+            }
+            auto contended = acquired - waits[0];
+            waits[0] = 0;
+            auto ns = [&](std::uint64_t a_ticks) { return static_cast<double>(a_ticks) * stats.nsPerTick; };
+            std::fprintf(file, "%-24s %14llu %10llu %10.0f %10.0f %10.0f %10.0f\n", LockName(static_cast<Lock>(l)),
+                static_cast<unsigned long long>(acquired), static_cast<unsigned long long>(contended), ns(Percentile(waits, 0.5)),
+                ns(Percentile(waits, 1.0)), ns(Percentile(stats.lockHolds[l], 0.5)), ns(Percentile(stats.lockHolds[l], 1.0)));
+        }
+        std::fclose(file);
+    }
+
+    void Metrics::Run(std::stop_token a_stop) {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!a_stop.stop_requested()) {
+            wake.wait_for(lock, a_stop, DUMP_INTERVAL, [] { return false; });
+            if (IsEnabled()) {
+                Dump();
+            }
+        }
+    }
+
+    const char* Metrics::CounterName(Counter a_counter) {
+        switch (a_counter) {
+        case Counter::kProcessEvent:
+            return "ProcessEvent";
+        case Counter::kRejectNoActor:
+            return "RejectNoActor";
+        case Counter::kRejectUnknownTag:
+            return "RejectUnknownTag";
+        case Counter::kRejectNotEligible:
+            return "RejectNotEligible";
+        case Counter::kRejectQueueFull:
+            return "RejectQueueFull";
+        case Counter::kRejectNPCsDisabled:
+            return "RejectNPCsDisabled";
+        case Counter::kRejectNotInCombat:
+            return "RejectNotInCombat";
+        case Counter::kCastSpell:
+            return "CastSpell";
+        case Counter::kDispelSpell:
+            return "DispelSpell";
+        case Counter::kModifySpeedMult:
+            return "ModifySpeedMult";
+        default:
+            return "?";
+        }
+    }
+
+    const char* Metrics::HistogramName(Histogram a_histogram) {
+        switch (a_histogram) {
+        case Histogram::kApplySlowdown:
+            return "ApplySlowdown";
+        case Histogram::kRemoveSlowdown:
+            return "RemoveSlowdown";
+        case Histogram::kEventQueueDelay:
+            return "EventQueueDelay";
+        default:
+            return "?";
+        }
+    }
+
+    const char* Metrics::LockName(Lock a_lock) {
+        switch (a_lock) {
+        case Lock::kRegistration:
+            return "Registration";
+        case Lock::kPendingActors:
+            return "PendingActors";
+        case Lock::kTimerWheel:
+            return "TimerWheel";
+        default:
+            return "?";
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include "SIGA/PlayerGraphHandler.h"
+#include "SIGA/AnimationHandler.h"
+#include "SIGA/Log.h"
+#include "SIGA/SlowMotion.h"
+#include "SIGA/WeaponCache.h"
+
+namespace SIGA {
+
+    bool PlayerGraphHandler::Register() {
+        auto player = RE::PlayerCharacter::GetSingleton();
+        if (!player) {
+            return false;
+        }
+
+        if (!player->AddAnimationGraphEventSink(AnimationEventHandler::GetSingleton())) {
+            SIGA_LOG_DEBUG("Player has no animation graph yet - registering when 3D loads");
+            return false;
+        }
+
+        WeaponCache::GetSingleton()->Refresh(player);
+        SIGA_LOG_DEBUG("Animation events registered for player");
+        return true;
+    }
+
+    RE::BSEventNotifyControl PlayerGraphHandler::ProcessEvent(
+        const RE::TESObjectLoadedEvent* a_event,
+        RE::BSTEventSource<RE::TESObjectLoadedEvent>* a_eventSource)
+    {
+        // The player is always 0x14
+        if (a_event && a_event->loaded && a_event->formID == 0x14) {
+            OnGraphRebuilt("3D loaded");
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    RE::BSEventNotifyControl PlayerGraphHandler::ProcessEvent(
+        const RE::TESSwitchRaceCompleteEvent* a_event,
+        RE::BSTEventSource<RE::TESSwitchRaceCompleteEvent>* a_eventSource)
+    {
+        if (a_event && a_event->subject && a_event->subject->IsPlayerRef()) {
+            OnGraphRebuilt("race switched");
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    void PlayerGraphHandler::OnGraphRebuilt(const char* a_reason) {
+        SIGA_LOG_DEBUG("Player animation graph rebuilt ({})", a_reason);
+
+        auto player = RE::PlayerCharacter::GetSingleton();
+        if (player && SlowMotionManager::GetSingleton()->IsActorSlowed(player)) {
+            SlowMotionManager::GetSingleton()->ClearAllSlowdowns(player);
+        }
+        Register();
+    }
+
+}
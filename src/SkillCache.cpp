@@ -0,0 +1,125 @@
+#include "SIGA/SkillCache.h"
+#include "SIGA/Log.h"
+
+namespace SIGA {
+
+    float SkillCache::GetSkill(RE::Actor* a_actor, RE::ActorValue a_skill) {
+        auto column = ColumnOf(a_skill);
+        return column ? Read(a_actor, *column) : a_actor->AsActorValueOwner()->GetActorValue(a_skill);
+    }
+
+    float SkillCache::GetMagicAverage(RE::Actor* a_actor) {
+        return Read(a_actor, kMagicAverage);
+    }
+
+    void SkillCache::Invalidate(RE::ActorHandle a_handle) {
+        rows.Update(a_handle, false, [](std::uint32_t) { return 0u; });
+    }
+
+    void SkillCache::Forget(RE::ActorHandle a_handle) {
+        Invalidate(a_handle);
+        rows.Release(a_handle);
+    }
+
+    void SkillCache::InvalidateAll() {
+        epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void SkillCache::Clear() {
+        rows.Drain([](RE::ActorHandle, std::uint32_t) {});
+    }
+
+    RE::BSEventNotifyControl SkillCache::ProcessEvent(
+        const RE::SkillIncrease::Event* a_event,
+        RE::BSTEventSource<RE::SkillIncrease::Event>* a_eventSource)
+    {
+        if (a_event && a_event->player) {
+            Invalidate(a_event->player->GetHandle());
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    RE::BSEventNotifyControl SkillCache::ProcessEvent(
+        const RE::LevelIncrease::Event* a_event,
+        RE::BSTEventSource<RE::LevelIncrease::Event>* a_eventSource)
+    {
+        // Leveled NPCs scale with the player, so every row may be out of date
+        SIGA_LOG_DEBUG("Player level up - skill cache invalidated");
+        InvalidateAll();
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    RE::BSEventNotifyControl SkillCache::ProcessEvent(
+        const RE::TESEquipEvent* a_event,
+        RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource)
+    {
+        auto actor = a_event && a_event->actor ? a_event->actor->As<RE::Actor>() : nullptr;
+        if (actor) {
+            Invalidate(actor->GetHandle());
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    std::uint64_t SkillCache::GetRefreshCount() const {
+        return refreshes.load(std::memory_order_relaxed);
+    }
+
+    void SkillCache::ResetRefreshCount() {
+        refreshes.store(0, std::memory_order_relaxed);
+    }
+
+    std::optional<SkillCache::Column> SkillCache::ColumnOf(RE::ActorValue a_skill) {
+        switch (a_skill) {
+        case RE::ActorValue::kArchery:
+            return kArchery;
+        case RE::ActorValue::kDestruction:
+            return kDestruction;
+        case RE::ActorValue::kRestoration:
+            return kRestoration;
+        case RE::ActorValue::kAlteration:
+            return kAlteration;
+        case RE::ActorValue::kConjuration:
+            return kConjuration;
+        case RE::ActorValue::kIllusion:
+            return kIllusion;
+        default:
+            return std::nullopt;
+        }
+    }
+
+    float SkillCache::Read(RE::Actor* a_actor, Column a_column) {
+        auto handle = a_actor->GetHandle();
+        auto current = CurrentWord();
+
+        // An unchanged state finds the slot without writing. The row word was published after
+        // its columns, and the lookup's acquire load makes them visible.
+        auto row = rows.Update(handle, true, [](std::uint32_t a_state) { return a_state; });
+        if (row && row->oldState == current) {
+            return columns[a_column][row->slot].load(std::memory_order_relaxed);
+        }
+
+        refreshes.fetch_add(1, std::memory_order_relaxed);
+        auto avOwner = a_actor->AsActorValueOwner();
+        std::array<float, kColumnCount> values{};
+        values[kArchery] = avOwner->GetActorValue(RE::ActorValue::kArchery);
+        values[kDestruction] = avOwner->GetActorValue(RE::ActorValue::kDestruction);
+        values[kRestoration] = avOwner->GetActorValue(RE::ActorValue::kRestoration);
+        values[kAlteration] = avOwner->GetActorValue(RE::ActorValue::kAlteration);
+        values[kConjuration] = avOwner->GetActorValue(RE::ActorValue::kConjuration);
+        values[kIllusion] = avOwner->GetActorValue(RE::ActorValue::kIllusion);
+        values[kMagicAverage] = (values[kDestruction] + values[kRestoration] + values[kAlteration] +
+                                 values[kConjuration] + values[kIllusion]) * 0.2f;
+
+        // Fill the columns, then publish the row unless it was invalidated meanwhile; a full
+        // table just skips caching
+        if (row) {
+            for (std::uint32_t column = 0; column < kColumnCount; ++column) {
+                columns[column][row->slot].store(values[column], std::memory_order_relaxed);
+            }
+            auto seen = row->oldState;
+            rows.Update(handle, false, [seen, current](std::uint32_t a_state) { return a_state == seen ? current : a_state; });
+        }
+        return values[a_column];
+    }
+
+}
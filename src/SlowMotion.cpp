@@ -1,5 +1,11 @@
 #include "SIGA/SlowMotion.h"
 #include "SIGA/Config.h"
+#include "SIGA/Log.h"
+#include "SIGA/Metrics.h"
+#include "SIGA/SlowdownTimers.h"
+#include "SIGA/TraceLog.h"
+#include <algorithm>
+#include <cmath>
 
 namespace SIGA {
 
@@ -9,7 +15,7 @@ namespace SIGA {
     }
 
     bool SlowMotionManager::Initialize() {
-        auto config = Config::GetSingleton();
+        auto config = Config::GetSingleton()->GetSnapshot();
         auto dataHandler = RE::TESDataHandler::GetSingleton();
         if (!dataHandler) {
             logger::error("Failed to get TESDataHandler");
@@ -47,221 +53,606 @@ namespace SIGA {
             logger::info("All debuff spells loaded successfully");
         }
 
+        BuildSpellVariants(*config);
+
+        SetBackend(config->slowdownBackend);
+
         return success;
     }
 
-    void SlowMotionManager::ApplySlowdown(RE::Actor* actor, SlowType type, float skillLevel) {
+    void SlowMotionManager::ApplySlowdown(RE::Actor* actor, SlowType type, float skillLevel, const Config::Snapshot* a_config) {
         if (!actor) {
             logger::warn("ApplySlowdown called with null actor");
             return;
         }
-
-        std::lock_guard<std::mutex> lock(actorStatesMutex);
+        Metrics::ScopedTimer timer(Metrics::Histogram::kApplySlowdown);
+        TraceLog::ScopedSpan span(Trace::Span::kApplySlowdown, actor->GetFormID(), static_cast<std::uint32_t>(type));
 
         auto formID = actor->GetFormID();
-        auto [it, inserted] = actorStates.try_emplace(formID);
-        auto& state = it->second;
+        auto handle = actor->GetHandle();
+        auto stateBit = StateBitFor(type);
+
+        // Set the flag, and detect dual cast, in one atomic step
+        auto transition = actorStates.Update(handle, true, [stateBit, type](std::uint32_t state) {
+            state |= stateBit;
+            if (type == SlowType::Bow) {
+                state &= ~kCrossbowWeapon;
+            }
+            else if (type == SlowType::Crossbow) {
+                state |= kCrossbowWeapon;
+            }
+            if ((state & kCastLeftActive) && (state & kCastRightActive)) {
+                state |= kDualCastActive;
+            }
+            return state;
+        });
+        if (!transition) {
+            logger::warn("Actor state table full ({} actors), or actor has no handle - slowdown skipped for {:X}", MAX_TRACKED_ACTORS, formID);
+            return;
+        }
+        auto state = transition->newState;
 
-        logger::debug("ApplySlowdown: type={}, skillLevel={}", static_cast<int>(type), skillLevel);
+        SIGA_LOG_DEBUG("ApplySlowdown: type={}, skillLevel={}", static_cast<int>(type), skillLevel);
 
-        // Determine which spell to use
-        RE::SpellItem* spellToApply = nullptr;
-        bool isDualCast = false;
+        // Magnitude and tier for the actor's skill, and the prebuilt variant for that tier
+        auto config = a_config ? a_config : Config::GetSingleton()->GetSnapshot();
 
-        switch (type) {
-        case SlowType::Bow:
-            state.bowSlowActive = true;
-            spellToApply = bowDebuffSpell;
-            break;
-        case SlowType::Crossbow:
-            state.bowSlowActive = true;
-            spellToApply = crossbowDebuffSpell;
-            break;
-        case SlowType::CastLeft:
-            state.castLeftActive = true;
-            spellToApply = castingDebuffSpell;
-            break;
-        case SlowType::CastRight:
-            state.castRightActive = true;
-            spellToApply = castingDebuffSpell;
-            break;
+        // Cleared for the actor if no animation event renews it in time, e.g. after a lost release
+        SlowdownTimers::GetSingleton()->Arm(handle, config->stuckSlowdownTimeout);
+        auto desired = LookupEffect(*config, type, skillLevel);
+        auto tier = desired.tier;
+        RE::SpellItem* spellToApply = VariantFor(type, tier);
+
+        if (!spellToApply) {
+            logger::error("No spell found for slowdown type {}", static_cast<int>(type));
+            return;
         }
 
+        // Record the desired effect before queueing so the flush never reads a stale one
+        auto slot = transition->slot;
+        bool isCast = type == SlowType::CastLeft || type == SlowType::CastRight;
+        auto previous = (isCast ? castEffects[slot] : bowEffects[slot]).exchange(desired, std::memory_order_acq_rel);
+        bool changed = transition->oldState != state || previous.tier != tier || !SameMagnitude(previous.magnitude, desired.magnitude);
+
         // Check for dual cast
-        if (state.castLeftActive && state.castRightActive) {
-            state.dualCastActive = true;
-            isDualCast = true;
-            spellToApply = dualCastDebuffSpell;
-            type = SlowType::DualCast;
-            logger::debug("Dual casting detected!");
+        if (isCast && (state & kDualCastActive)) {
+            desired = LookupEffect(*config, SlowType::DualCast, skillLevel);
+            tier = desired.tier;
+            spellToApply = VariantFor(SlowType::DualCast, tier);
+            previous = dualCastEffects[slot].exchange(desired, std::memory_order_acq_rel);
+            changed = changed || previous.tier != tier || !SameMagnitude(previous.magnitude, desired.magnitude);
+            SIGA_LOG_DEBUG("Dual casting detected!");
         }
 
-        if (!spellToApply) {
-            logger::error("No spell found for slowdown type {}", static_cast<int>(type));
+        immediateCalls.fetch_add(1, std::memory_order_relaxed);
+        if (!changed) {
+            // Repeated draw/cast event at the same tier: the ledger already matches
             return;
         }
 
-        // Calculate magnitude based on skill level
-        float magnitude = CalculateMagnitude(skillLevel, type);
-
-        // Apply the spell with the calculated magnitude
-        logger::debug("Applying {} to actor (magnitude: {})", spellToApply->GetName(), magnitude);
-        ApplySpellWithMagnitude(actor, spellToApply, magnitude);
+        SIGA_LOG_DEBUG("Queued {} for actor (magnitude: {})", spellToApply ? spellToApply->GetName() : "<none>", desired.magnitude);
+        TraceLog::GetSingleton()->Record(Trace::Format::kApplySlowdown, formID, static_cast<std::uint32_t>(type), desired.magnitude);
+        MarkPending(handle);
     }
 
     void SlowMotionManager::RemoveSlowdown(RE::Actor* actor, SlowType type) {
         if (!actor) return;
+        Metrics::ScopedTimer timer(Metrics::Histogram::kRemoveSlowdown);
+        TraceLog::ScopedSpan span(Trace::Span::kRemoveSlowdown, actor->GetFormID(), static_cast<std::uint32_t>(type));
 
-        std::lock_guard<std::mutex> lock(actorStatesMutex);
+        auto handle = actor->GetHandle();
+        auto stateBit = StateBitFor(type);
 
-        auto formID = actor->GetFormID();
-        auto it = actorStates.find(formID);
-        if (it == actorStates.end()) return;
+        // Update state flags; if both cast hands are released, disable dual cast
+        auto transition = actorStates.Update(handle, false, [stateBit](std::uint32_t state) {
+            state &= ~stateBit;
+            if (!(state & kCastLeftActive) || !(state & kCastRightActive)) {
+                state &= ~kDualCastActive;
+            }
+            return state;
+        });
+        if (!transition || !(transition->oldState & ACTIVE_MASK)) return;
 
-        auto& state = it->second;
+        auto state = transition->newState;
 
-        // Update state flags
-        switch (type) {
-        case SlowType::Bow:
-        case SlowType::Crossbow:
-            state.bowSlowActive = false;
-            break;
-        case SlowType::CastLeft:
-            state.castLeftActive = false;
-            break;
-        case SlowType::CastRight:
-            state.castRightActive = false;
-            break;
-        case SlowType::DualCast:
-            state.dualCastActive = false;
-            break;
+        // The dispels removing each slowdown immediately used to cost
+        std::uint64_t dispels = (state & kBowSlowActive) ? 2 : 0;
+        dispels += (state & (kDualCastActive | kCastLeftActive | kCastRightActive)) ? 1 : 2;
+        immediateCalls.fetch_add(dispels, std::memory_order_relaxed);
+
+        if (!(state & ACTIVE_MASK)) {
+            SIGA_LOG_DEBUG("Removed all slowdowns for actor");
         }
+        TraceLog::GetSingleton()->Record(Trace::Format::kRemoveSlowdown, actor->GetFormID(), static_cast<std::uint32_t>(type));
+        MarkPending(handle);
+    }
+
+    void SlowMotionManager::ClearAllSlowdowns(RE::Actor* actor) {
+        if (!actor) return;
+        ClearAllSlowdowns(actor->GetHandle());
+    }
+
+    bool SlowMotionManager::ClearAllSlowdowns(RE::ActorHandle handle) {
+        auto transition = actorStates.Update(handle, false, [](std::uint32_t state) { return state & kFlushPending; });
+        if (!transition || !(transition->oldState & ACTIVE_MASK)) return false;
 
-        // If both cast hands are released, disable dual cast
-        if (!state.castLeftActive || !state.castRightActive) {
-            state.dualCastActive = false;
+        immediateCalls.fetch_add(4, std::memory_order_relaxed);
+        SIGA_LOG_DEBUG("Cleared all slowdowns for actor");
+        if (auto actor = handle.get()) {
+            TraceLog::GetSingleton()->Record(Trace::Format::kClearActor, actor->GetFormID());
         }
+        MarkPending(handle);
+        return true;
+    }
 
-        // Remove all active spells
-        if (state.bowSlowActive) {
-            RemoveSpell(actor, bowDebuffSpell);
-            RemoveSpell(actor, crossbowDebuffSpell);
+    void SlowMotionManager::ClearAll() {
+        TraceLog::ScopedSpan span(Trace::Span::kClearAll);
+        auto usedSlots = DrainStates();
+
+        // OPTIMIZATION: Dispel whatever the ledger says is still applied, walking the dense
+        // prefix and resolving each actor by handle rather than through the form table
+        for (std::uint32_t slot = 0; slot < usedSlots; ++slot) {
+            auto& ledger = effectLedger[slot];
+            auto actor = ledger.handle.get();
+            if (actor) {
+                for (auto& entry : ledger.channels) {
+                    SyncChannel(actor.get(), entry, nullptr, 0.0f);
+                }
+            }
+            ledger = {};
         }
-        if (state.dualCastActive) {
-            RemoveSpell(actor, dualCastDebuffSpell);
-        } else if (state.castLeftActive || state.castRightActive) {
-            RemoveSpell(actor, castingDebuffSpell);
-        } else {
-            // No casting active, remove casting spells
-            RemoveSpell(actor, castingDebuffSpell);
-            RemoveSpell(actor, dualCastDebuffSpell);
+        SIGA_LOG_DEBUG("Cleared all slowdowns for all actors");
+        TraceLog::GetSingleton()->Record(Trace::Format::kClearAll, 0);
+    }
+
+    void SlowMotionManager::ForgetAll() {
+        auto usedSlots = DrainStates();
+        std::fill_n(effectLedger.begin(), usedSlots, ActorLedger{});
+        SIGA_LOG_DEBUG("Forgot all slowdowns for all actors");
+    }
+
+    std::uint32_t SlowMotionManager::DrainStates() {
+        // Ledger entries only exist below the slots handed out since the last drain
+        auto usedSlots = actorStates.GetUsedSlots();
+        actorStates.Drain([](RE::ActorHandle, std::uint32_t) {});
+        for (auto& shard : pendingShards) {
+            Metrics::TimedLock lock(shard.mutex, Metrics::Lock::kPendingActors);
+            shard.actors.clear();
         }
+        return usedSlots;
+    }
 
-        // If no slowdowns are active, clean up state
-        if (!IsActorSlowedInternal(formID)) {
-            actorStates.erase(it);
-            logger::debug("Removed all slowdowns for actor");
+    void SlowMotionManager::SetBackend(Config::SlowdownBackend a_backend) {
+        if (a_backend == backend) {
+            return;
         }
+
+        // The ledger's entries are only meaningful to the backend that applied them
+        ClearAll();
+        backend = a_backend;
+        logger::info("Slowdown backend: {}", a_backend == Config::SlowdownBackend::kSpeedMult ? "SpeedMult modifier" : "debuff spells");
     }
 
-    void SlowMotionManager::ClearAllSlowdowns(RE::Actor* actor) {
-        if (!actor) return;
+    bool SlowMotionManager::IsActorSlowed(RE::Actor* actor) {
+        if (!actor) return false;
+
+        // Wait-free: a single probe of the state table
+        return (actorStates.Load(actor->GetHandle()) & ACTIVE_MASK) != 0;
+    }
 
-        std::lock_guard<std::mutex> lock(actorStatesMutex);
+    void SlowMotionManager::ApplyConfigChange(const Config::Snapshot& a_previous, const Config::Snapshot& a_current) {
+        SetBackend(a_current.slowdownBackend);
 
-        auto formID = actor->GetFormID();
-        auto it = actorStates.find(formID);
-        if (it == actorStates.end()) return;
+        // Casts pass the exact magnitude anyway; this keeps the spells themselves in step
+        if (a_previous.bowMultipliers != a_current.bowMultipliers || a_previous.crossbowMultipliers != a_current.crossbowMultipliers ||
+            a_previous.castMultipliers != a_current.castMultipliers || a_previous.dualCastMultipliers != a_current.dualCastMultipliers) {
+            StampSpellVariants(a_current);
+        }
+
+        bool clearBow = a_previous.enableBowDebuff && !a_current.enableBowDebuff;
+        bool clearCrossbow = a_previous.enableCrossbowDebuff && !a_current.enableCrossbowDebuff;
+        bool clearCast = a_previous.enableCastDebuff && !a_current.enableCastDebuff;
+        bool clearDualCast = a_previous.enableDualCastDebuff && !a_current.enableDualCastDebuff;
+        if (!clearBow && !clearCrossbow && !clearCast && !clearDualCast) {
+            return;
+        }
 
-        // Remove all spell effects
-        RemoveSpell(actor, bowDebuffSpell);
-        RemoveSpell(actor, crossbowDebuffSpell);
-        RemoveSpell(actor, castingDebuffSpell);
-        RemoveSpell(actor, dualCastDebuffSpell);
+        auto clearMask = [=](std::uint32_t state) {
+            std::uint32_t mask = 0;
+            if ((state & kCrossbowWeapon) ? clearCrossbow : clearBow) mask |= kBowSlowActive;
+            if (clearCast) mask |= kCastLeftActive | kCastRightActive | kDualCastActive;
+            if (clearDualCast) mask |= kDualCastActive;
+            return mask;
+        };
+
+        // Only state bits change here; the flushes dispel, a bounded number of actors per frame
+        std::vector<RE::ActorHandle> affected;
+        actorStates.ForEach([&](RE::ActorHandle handle, std::uint32_t state) {
+            if (state & clearMask(state)) {
+                affected.push_back(handle);
+            }
+        });
+
+        for (auto handle : affected) {
+            auto transition = actorStates.Update(handle, false, [&](std::uint32_t state) { return state & ~clearMask(state); });
+            if (transition && transition->oldState != transition->newState) {
+                MarkPending(handle);
+            }
+        }
 
-        actorStates.erase(it);
-        logger::debug("Cleared all slowdowns for actor");
+        TraceLog::GetSingleton()->Record(Trace::Format::kConfigReload, 0, static_cast<std::uint32_t>(affected.size()));
+        if (!affected.empty()) {
+            logger::info("Config reload disabled a debuff type; clearing it from {} actors", affected.size());
+        }
     }
 
-    void SlowMotionManager::ClearAll() {
-        std::lock_guard<std::mutex> lock(actorStatesMutex);
-
-        for (auto& [formID, state] : actorStates) {
-            if (auto actor = RE::TESForm::LookupByID<RE::Actor>(formID)) {
-                RemoveSpell(actor, bowDebuffSpell);
-                RemoveSpell(actor, crossbowDebuffSpell);
-                RemoveSpell(actor, castingDebuffSpell);
-                RemoveSpell(actor, dualCastDebuffSpell);
+    void SlowMotionManager::MarkPending(RE::ActorHandle handle) {
+        auto transition = actorStates.Update(handle, false, [](std::uint32_t state) { return state | kFlushPending; });
+        if (!transition || (transition->oldState & kFlushPending)) {
+            // Already queued this frame; the flush will pick up the latest state
+            return;
+        }
+
+        {
+            auto& shard = ShardOf(handle);
+            Metrics::TimedLock lock(shard.mutex, Metrics::Lock::kPendingActors);
+            shard.actors.push_back(handle);
+        }
+        ScheduleFlush();
+    }
+
+    void SlowMotionManager::ScheduleFlush() {
+        if (flushScheduled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        // Callers include the timer thread and combat event threads, and a flush makes engine
+        // calls, so it only ever runs as a main-thread task. Without a task interface the
+        // actors stay pending until the next flush that does run.
+        if (auto taskInterface = SKSE::GetTaskInterface()) {
+            // The animation event drain may already have flushed this frame
+            taskInterface->AddTask([this]() {
+                if (flushScheduled.load(std::memory_order_acquire)) {
+                    Flush();
+                }
+            });
+        }
+    }
+
+    void SlowMotionManager::Flush() {
+        TraceLog::ScopedSpan span(Trace::Span::kFlush);
+        // Clear the flag first: anything queued after this point schedules the next flush
+        flushScheduled.store(false, std::memory_order_release);
+        for (auto& shard : pendingShards) {
+            Metrics::TimedLock lock(shard.mutex, Metrics::Lock::kPendingActors);
+            flushBatch.insert(flushBatch.end(), shard.actors.begin(), shard.actors.end());
+            shard.actors.clear();
+        }
+
+        auto count = std::min(flushBatch.size(), MAX_SYNCS_PER_FLUSH);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto handle = flushBatch[i];
+            // Clearing the pending bit before reading magnitudes means a later change re-queues
+            auto transition = actorStates.Update(handle, false, [](std::uint32_t state) { return state & ~kFlushPending; });
+            if (transition) {
+                SyncActor(handle, transition->slot, transition->newState);
+                ReleaseIfIdle(handle, transition->slot, transition->newState);
+            }
+        }
+
+        if (count < flushBatch.size()) {
+            // A bulk change, such as a reload disabling a debuff mid-battle, is spread over
+            // several frames. These actors are still marked pending, so nothing re-queues them;
+            // the first shard takes them all so they go first next frame.
+            {
+                auto& shard = pendingShards.front();
+                Metrics::TimedLock lock(shard.mutex, Metrics::Lock::kPendingActors);
+                shard.actors.insert(shard.actors.begin(), flushBatch.begin() + count, flushBatch.end());
             }
+            ScheduleFlush();
         }
-        actorStates.clear();
-        logger::debug("Cleared all slowdowns for all actors");
+
+        flushBatch.clear();
+        flushCount.fetch_add(1, std::memory_order_relaxed);
     }
 
-    bool SlowMotionManager::IsActorSlowed(RE::Actor* actor) {
-        if (!actor) return false;
+    void SlowMotionManager::SyncActor(RE::ActorHandle handle, std::uint32_t slot, std::uint32_t state) {
+        auto& ledger = effectLedger[slot];
+        if (ledger.handle != handle) {
+            // Slot reused after ClearAll or a release, which left nothing applied for the previous occupant
+            ledger = {};
+            ledger.handle = handle;
+        }
+
+        RE::SpellItem* desiredBow = nullptr;
+        auto bowEffect = bowEffects[slot].load(std::memory_order_acquire);
+        if (state & kBowSlowActive) {
+            desiredBow = VariantFor((state & kCrossbowWeapon) ? SlowType::Crossbow : SlowType::Bow, bowEffect.tier);
+        }
 
-        std::lock_guard<std::mutex> lock(actorStatesMutex);
-        return IsActorSlowedInternal(actor->GetFormID());
+        RE::SpellItem* desiredCast = nullptr;
+        DesiredEffect castEffect;
+        if (state & kDualCastActive) {
+            castEffect = dualCastEffects[slot].load(std::memory_order_acquire);
+            desiredCast = VariantFor(SlowType::DualCast, castEffect.tier);
+        }
+        else if (state & (kCastLeftActive | kCastRightActive)) {
+            castEffect = castEffects[slot].load(std::memory_order_acquire);
+            desiredCast = VariantFor(SlowType::CastLeft, castEffect.tier);
+        }
+
+        auto& bow = ledger.channels[kBowChannel];
+        auto& cast = ledger.channels[kCastChannel];
+        if (!desiredBow && !desiredCast && !bow.spell && !cast.spell) {
+            // Applied and removed within the same frame: the engine never sees it
+            return;
+        }
+
+        // A handle resolves through the engine's handle table, not the form table
+        auto actor = handle.get();
+        if (!actor) {
+            // Gone from the game, and its effects with it
+            ledger = {};
+            ledger.handle = handle;
+            return;
+        }
+
+        SyncChannel(actor.get(), bow, desiredBow, bowEffect.magnitude);
+        SyncChannel(actor.get(), cast, desiredCast, castEffect.magnitude);
+    }
+
+    void SlowMotionManager::ReleaseIfIdle(RE::ActorHandle handle, std::uint32_t slot, std::uint32_t state) {
+        auto& ledger = effectLedger[slot];
+        if (state != 0 || ledger.channels[kBowChannel].spell || ledger.channels[kCastChannel].spell) {
+            return;
+        }
+
+        // Nothing wanted and nothing applied: give the slot back. An event that slowed the
+        // actor again since the flush read its state keeps it.
+        if (actorStates.Release(handle)) {
+            ledger = {};
+        }
+    }
+
+    void SlowMotionManager::SyncChannel(RE::Actor* actor, LedgerEntry& entry, RE::SpellItem* desiredSpell, float desiredMagnitude) {
+        if (entry.spell == desiredSpell && (!desiredSpell || SameMagnitude(entry.magnitude, desiredMagnitude))) {
+            return;
+        }
+
+        if (backend == Config::SlowdownBackend::kSpeedMult) {
+            SyncModifier(actor, entry, desiredSpell, desiredMagnitude);
+            return;
+        }
+
+        // Recasting the same spell refreshes its magnitude; only a different spell needs a dispel
+        if (entry.spell && entry.spell != desiredSpell) {
+            if (RemoveSpell(actor, entry.spell)) {
+                dispelCalls.fetch_add(1, std::memory_order_relaxed);
+                TraceLog::GetSingleton()->Record(Trace::Format::kDispelSpell, actor->GetFormID(), entry.spell->GetFormID());
+                Metrics::GetSingleton()->Count(Metrics::Counter::kDispelSpell);
+            }
+            entry = {};
+        }
+        if (desiredSpell) {
+            if (ApplySpellWithMagnitude(actor, desiredSpell, desiredMagnitude)) {
+                castCalls.fetch_add(1, std::memory_order_relaxed);
+                TraceLog::GetSingleton()->Record(Trace::Format::kCastSpell, actor->GetFormID(), desiredSpell->GetFormID(), desiredMagnitude);
+                Metrics::GetSingleton()->Count(Metrics::Counter::kCastSpell);
+                entry = { desiredSpell, desiredMagnitude };
+            }
+        }
+    }
+
+    void SlowMotionManager::SyncModifier(RE::Actor* actor, LedgerEntry& entry, RE::SpellItem* desiredSpell, float desiredMagnitude) {
+        // The spell only names the channel's effect here; the entry's magnitude is exactly
+        // what we took off SpeedMult, so one net change moves it to the desired value
+        float desired = desiredSpell ? std::round(desiredMagnitude / MODIFIER_STEP) * MODIFIER_STEP : 0.0f;
+        float applied = entry.spell ? entry.magnitude : 0.0f;
+
+        if (applied != desired) {
+            if (!ModifySpeedMult(actor, applied - desired)) {
+                return;
+            }
+            modifierCalls.fetch_add(1, std::memory_order_relaxed);
+            TraceLog::GetSingleton()->Record(Trace::Format::kModifySpeedMult, actor->GetFormID(), 0, applied - desired);
+            Metrics::GetSingleton()->Count(Metrics::Counter::kModifySpeedMult);
+        }
+        entry = desiredSpell ? LedgerEntry{ desiredSpell, desired } : LedgerEntry{};
+    }
+
+    bool SlowMotionManager::ModifySpeedMult(RE::Actor* actor, float delta) {
+        auto avOwner = actor->AsActorValueOwner();
+        if (!avOwner) {
+            logger::warn("Failed to get actor value owner for actor");
+            return false;
+        }
+
+        avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kTemporary, RE::ActorValue::kSpeedMult, delta);
+
+        // Movement speed is only recomputed when carry weight changes, so nudge it
+        avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kTemporary, RE::ActorValue::kCarryWeight, 0.1f);
+        avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kTemporary, RE::ActorValue::kCarryWeight, -0.1f);
+        SIGA_LOG_DEBUG("Changed SpeedMult by {}", delta);
+        return true;
+    }
+
+    bool SlowMotionManager::SameMagnitude(float a, float b) {
+        return std::abs(a - b) < MAGNITUDE_EPSILON;
+    }
+
+    SlowMotionManager::CoalescingStats SlowMotionManager::GetCoalescingStats() const {
+        CoalescingStats stats;
+        stats.flushes = flushCount.load(std::memory_order_relaxed);
+        stats.castCalls = castCalls.load(std::memory_order_relaxed);
+        stats.dispelCalls = dispelCalls.load(std::memory_order_relaxed);
+        stats.modifierCalls = modifierCalls.load(std::memory_order_relaxed);
+
+        auto issued = stats.castCalls + stats.dispelCalls + stats.modifierCalls;
+        auto immediate = immediateCalls.load(std::memory_order_relaxed);
+        stats.savedCalls = immediate > issued ? immediate - issued : 0;
+        return stats;
+    }
+
+    void SlowMotionManager::ResetCoalescingStats() {
+        flushCount.store(0, std::memory_order_relaxed);
+        castCalls.store(0, std::memory_order_relaxed);
+        dispelCalls.store(0, std::memory_order_relaxed);
+        modifierCalls.store(0, std::memory_order_relaxed);
+        immediateCalls.store(0, std::memory_order_relaxed);
+    }
+
+    void SlowMotionManager::LogCoalescingStats() const {
+        auto stats = GetCoalescingStats();
+        if (stats.flushes == 0) {
+            return;
+        }
+
+        logger::info("Slowdown flushes: {} frames, {} casts, {} dispels, {} SpeedMult changes, {} engine calls saved by coalescing",
+            stats.flushes, stats.castCalls, stats.dispelCalls, stats.modifierCalls, stats.savedCalls);
+    }
+
+    std::uint32_t SlowMotionManager::StateBitFor(SlowType type) {
+        switch (type) {
+        case SlowType::Bow:
+        case SlowType::Crossbow:
+            return kBowSlowActive;
+        case SlowType::CastLeft:
+            return kCastLeftActive;
+        case SlowType::CastRight:
+            return kCastRightActive;
+        case SlowType::DualCast:
+            return kDualCastActive;
+        default:
+            break;
+        }
+        return 0;
     }
 
-    bool SlowMotionManager::IsActorSlowedInternal(RE::FormID formID) const {
-        auto it = actorStates.find(formID);
-        if (it == actorStates.end()) return false;
+    void SlowMotionManager::BuildSpellVariants(const Config::Snapshot& config) {
+        std::uint32_t built = 0;
+        for (auto type : VARIANT_ROWS) {
+            auto base = BaseSpellFor(type);
+            auto& variants = spellVariants[static_cast<std::size_t>(type)];
+            for (std::uint32_t tier = 0; tier < TIER_COUNT; ++tier) {
+                auto variant = base ? CreateSpellVariant(base) : nullptr;
+                if (variant) {
+                    ++built;
+                }
+                else if (base) {
+                    // Still castable: the magnitude override alone sets the strength
+                    logger::warn("Failed to create tier {} variant of {} - using the base spell", tier, base->GetName());
+                }
+                variants[tier] = variant ? variant : base;
+            }
+        }
+        spellVariants[static_cast<std::size_t>(SlowType::CastRight)] = spellVariants[static_cast<std::size_t>(SlowType::CastLeft)];
 
-        auto& state = it->second;
-        return state.bowSlowActive || state.castLeftActive ||
-            state.castRightActive || state.dualCastActive;
+        StampSpellVariants(config);
+        logger::info("Built {} debuff spell variants", built);
     }
 
-    float SlowMotionManager::CalculateMagnitude(float skillLevel, SlowType type) {
-        auto config = Config::GetSingleton();
+    void SlowMotionManager::StampSpellVariants(const Config::Snapshot& config) {
+        for (auto type : VARIANT_ROWS) {
+            auto& variants = spellVariants[static_cast<std::size_t>(type)];
+            for (std::uint32_t tier = 0; tier < TIER_COUNT; ++tier) {
+                // A tier that fell back to the base spell leaves the plugin's data alone
+                auto variant = variants[tier];
+                if (variant && variant != BaseSpellFor(type) && !variant->effects.empty()) {
+                    variant->effects[0]->effectItem.magnitude = MagnitudeForTier(config, type, tier);
+                }
+            }
+        }
+    }
 
-        // Determine skill tier
-        int tier = 0;
-        if (skillLevel <= 25) tier = 0;
-        else if (skillLevel <= 50) tier = 1;
-        else if (skillLevel <= 75) tier = 2;
-        else tier = 3;
+    RE::SpellItem* SlowMotionManager::BaseSpellFor(SlowType type) const {
+        switch (type) {
+        case SlowType::Bow:
+            return bowDebuffSpell;
+        case SlowType::Crossbow:
+            return crossbowDebuffSpell;
+        case SlowType::DualCast:
+            return dualCastDebuffSpell;
+        default:
+            return castingDebuffSpell;
+        }
+    }
 
+    RE::SpellItem* SlowMotionManager::CreateSpellVariant(RE::SpellItem* base) {
+        auto factory = RE::IFormFactory::GetConcreteFormFactoryByType<RE::SpellItem>();
+        auto variant = factory ? factory->Create() : nullptr;
+        if (!variant) {
+            return nullptr;
+        }
+
+        variant->fullName = base->fullName;
+        variant->data = base->data;
+
+        // Own copies of the effects, so the magnitude StampSpellVariants writes is this
+        // variant's alone. Our debuff effects carry no conditions, so those are not copied.
+        for (auto baseEffect : base->effects) {
+            if (!baseEffect) continue;
+
+            auto effect = new RE::Effect();
+            effect->effectItem = baseEffect->effectItem;
+            effect->baseEffect = baseEffect->baseEffect;
+            effect->cost = baseEffect->cost;
+            variant->effects.push_back(effect);
+        }
+
+        SIGA_LOG_DEBUG("Created variant {:X} of {}", variant->GetFormID(), base->GetName());
+        return variant;
+    }
+
+    RE::SpellItem* SlowMotionManager::VariantFor(SlowType type, std::uint32_t tier) const {
+        return spellVariants[static_cast<std::size_t>(type)][tier];
+    }
+
+    SlowMotionManager::DesiredEffect SlowMotionManager::LookupEffect(const Config::Snapshot& config, SlowType type, float skillLevel) {
+        auto index = MagnitudeCurve::SkillIndex(skillLevel);
+        switch (type) {
+        case SlowType::Bow:
+            return config.bowTable[index];
+        case SlowType::Crossbow:
+            return config.crossbowTable[index];
+        case SlowType::DualCast:
+            return config.dualCastTable[index];
+        default:
+            return config.castTable[index];
+        }
+    }
+
+    float SlowMotionManager::MagnitudeForTier(const Config::Snapshot& config, SlowType type, std::uint32_t tier) {
         // Get multiplier from config
         float multiplier = 1.0f;
         switch (type) {
         case SlowType::Bow:
-            multiplier = config->bowMultipliers[tier];
+            multiplier = config.bowMultipliers[tier];
             break;
         case SlowType::Crossbow:
-            multiplier = config->crossbowMultipliers[tier];
+            multiplier = config.crossbowMultipliers[tier];
             break;
         case SlowType::CastLeft:
         case SlowType::CastRight:
-            multiplier = config->castMultipliers[tier];
+            multiplier = config.castMultipliers[tier];
             break;
         case SlowType::DualCast:
-            multiplier = config->dualCastMultipliers[tier];
+            multiplier = config.dualCastMultipliers[tier];
+            break;
+        default:
             break;
         }
 
-        // Convert multiplier to magnitude
-        // multiplier 0.5 = 50% speed = need to REDUCE by 50 = magnitude 50
-        // multiplier 0.7 = 70% speed = need to REDUCE by 30 = magnitude 30
-        float magnitude = 100.0f - (multiplier * 100.0f);
-
-        logger::debug("Calculated magnitude: {} (multiplier: {}, tier: {})", magnitude, multiplier, tier);
+        float magnitude = MagnitudeCurve::MagnitudeFromMultiplier(multiplier);
+        SIGA_LOG_DEBUG("Calculated magnitude: {} (multiplier: {}, tier: {})", magnitude, multiplier, tier);
         return magnitude;
     }
 
-    void SlowMotionManager::ApplySpellWithMagnitude(RE::Actor* actor, RE::SpellItem* spell, float magnitude) {
-        if (!actor || !spell) return;
 
-        // First, modify the spell's magnitude
-        if (spell->effects.size() > 0) {
-            auto& effect = spell->effects[0];
-            if (effect) {
-                effect->effectItem.magnitude = magnitude;
-                logger::debug("Set spell effect magnitude to {}", effect->effectItem.magnitude);
-            }
-        }
+    bool SlowMotionManager::ApplySpellWithMagnitude(RE::Actor* actor, RE::SpellItem* spell, float magnitude) {
+        if (!actor || !spell) return false;
+
+        // The tier variant carries its tier's magnitude; the override gives the exact value
+        // from the skill curve without writing to the shared form
 
         // Cast the spell on the actor
         auto caster = actor->GetMagicCaster(RE::MagicSystem::CastingSource::kInstant);
@@ -275,14 +666,16 @@ namespace SIGA {
                 magnitude,                // magnitude override
                 nullptr                   // blame actor
             );
-            logger::debug("Cast spell {} on actor", spell->GetName());
+            SIGA_LOG_DEBUG("Cast spell {} on actor", spell->GetName());
+            return true;
         } else {
             logger::warn("Failed to get magic caster for actor");
+            return false;
         }
     }
 
-    void SlowMotionManager::RemoveSpell(RE::Actor* actor, RE::SpellItem* spell) {
-        if (!actor || !spell) return;
+    bool SlowMotionManager::RemoveSpell(RE::Actor* actor, RE::SpellItem* spell) {
+        if (!actor || !spell) return false;
 
         // Dispel the effect
         auto magicTarget = actor->GetMagicTarget();
@@ -290,7 +683,9 @@ namespace SIGA {
             // Get a null handle for the caster
             RE::BSPointerHandle<RE::Actor> nullHandle;
             magicTarget->DispelEffect(spell, nullHandle);
-            logger::debug("Dispelled spell {} from actor", spell->GetName());
+            SIGA_LOG_DEBUG("Dispelled spell {} from actor", spell->GetName());
+            return true;
         }
+        return false;
     }
 }
@@ -0,0 +1,153 @@
+#include "SIGA/SlowdownTimers.h"
+#include "SIGA/Log.h"
+#include "SIGA/Metrics.h"
+#include "SIGA/SlowMotion.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SIGA {
+    void SlowdownTimers::Start() {
+        Stop();
+        thread = std::jthread([this](std::stop_token a_stop) { Run(a_stop); });
+        logger::info("Stuck slowdown timers running, {} ms per tick", TICK.count());
+    }
+
+    void SlowdownTimers::Stop() {
+        if (thread.joinable()) {
+            thread.request_stop();
+            thread.join();
+        }
+    }
+
+    void SlowdownTimers::Run(std::stop_token a_stop) {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!a_stop.stop_requested()) {
+            // Returns early when Stop() is requested
+            wake.wait_for(lock, a_stop, TICK, [] { return false; });
+            if (!a_stop.stop_requested()) {
+                Tick();
+            }
+        }
+    }
+
+    std::uint32_t SlowdownTimers::DeadlineIn(float a_timeout) const {
+        auto ticks = static_cast<std::uint32_t>(std::ceil(a_timeout * 1000.0f / static_cast<float>(TICK.count())));
+        return (now.load(std::memory_order_relaxed) + std::max(ticks, 1u)) & DEADLINE_MASK;
+    }
+
+    void SlowdownTimers::Arm(RE::ActorHandle a_handle, float a_timeout) {
+        if (!(a_timeout > 0.0f)) {
+            return;
+        }
+
+        auto deadline = DeadlineIn(a_timeout);
+        auto transition = timers.Update(a_handle, true, [deadline](std::uint32_t) { return ARMED | deadline; });
+        if (!transition || (transition->oldState & ARMED)) {
+            // Already in the wheel (or the table is full); the new deadline is seen when its bucket comes up
+            return;
+        }
+
+        Metrics::TimedLock lock(wheelMutex, Metrics::Lock::kTimerWheel);
+        // A tick may have passed since the deadline was taken
+        Schedule(a_handle, std::max(deadline, now.load(std::memory_order_relaxed) + 1));
+    }
+
+    void SlowdownTimers::Renew(RE::ActorHandle a_handle, float a_timeout) {
+        if (!(a_timeout > 0.0f)) {
+            return;
+        }
+
+        // OPTIMIZATION: One CAS on the actor's word, no lock; the wheel is not touched
+        auto deadline = DeadlineIn(a_timeout);
+        timers.Update(a_handle, false, [deadline](std::uint32_t state) { return (state & ARMED) ? (ARMED | deadline) : state; });
+    }
+
+    void SlowdownTimers::Schedule(RE::ActorHandle a_handle, std::uint32_t a_deadline) {
+        auto current = now.load(std::memory_order_relaxed);
+        auto ticks = a_deadline > current ? a_deadline - current : 0;
+        if (ticks < WHEEL_SIZE) {
+            nearWheel[(current + ticks) & WHEEL_MASK].push_back(a_handle);
+        }
+        else {
+            auto group = std::min(a_deadline >> WHEEL_BITS, (current >> WHEEL_BITS) + WHEEL_SIZE);
+            farWheel[group & WHEEL_MASK].push_back(a_handle);
+        }
+    }
+
+    std::size_t SlowdownTimers::Tick() {
+        {
+            Metrics::TimedLock lock(wheelMutex, Metrics::Lock::kTimerWheel);
+            auto tick = now.load(std::memory_order_relaxed) + 1;
+            now.store(tick, std::memory_order_relaxed);
+
+            // Each time the near wheel wraps, the far wheel's next bucket is spread over it
+            if ((tick & WHEEL_MASK) == 0) {
+                due.swap(farWheel[(tick >> WHEEL_BITS) & WHEEL_MASK]);
+                for (auto handle : due) {
+                    auto state = timers.Load(handle);
+                    if (state & ARMED) {
+                        Schedule(handle, state & DEADLINE_MASK);
+                    }
+                }
+                due.clear();
+            }
+
+            due.swap(nearWheel[tick & WHEEL_MASK]);
+            for (auto handle : due) {
+                // Disarm only if the deadline still stands; a renewal racing this keeps the actor
+                auto transition = timers.Update(handle, false, [tick](std::uint32_t state) {
+                    return ((state & ARMED) && (state & DEADLINE_MASK) <= tick) ? 0 : state;
+                });
+                if (!transition || !(transition->oldState & ARMED)) {
+                    continue;
+                }
+                if (transition->newState != 0) {
+                    // Renewed since it was scheduled
+                    Schedule(handle, transition->newState & DEADLINE_MASK);
+                    continue;
+                }
+                // Unless an Arm got in first, the actor is out of the wheel and its slot free
+                timers.Release(handle);
+                expiredBatch.push_back(handle);
+            }
+            due.clear();
+        }
+
+        // Cleared after the wheel is released, so Arm from a thread applying a slowdown
+        // never waits on the flush these queue
+        std::size_t cleared = 0;
+        for (auto handle : expiredBatch) {
+            // Actors whose slowdowns already ended normally just drop out here
+            if (SlowMotionManager::GetSingleton()->ClearAllSlowdowns(handle)) {
+                SIGA_LOG_DEBUG("Slowdown on handle {:X} timed out", handle.native_handle());
+                ++cleared;
+            }
+        }
+        expiredBatch.clear();
+
+        if (cleared) {
+            logger::warn("Detected {} stuck slowdown(s) with no animation activity, forcing cleanup", cleared);
+        }
+
+        expired.fetch_add(cleared, std::memory_order_relaxed);
+        return cleared;
+    }
+
+    void SlowdownTimers::Clear() {
+        Metrics::TimedLock lock(wheelMutex, Metrics::Lock::kTimerWheel);
+        for (auto& bucket : nearWheel) {
+            bucket.clear();
+        }
+        for (auto& bucket : farWheel) {
+            bucket.clear();
+        }
+        timers.Drain([](RE::ActorHandle, std::uint32_t) {});
+    }
+
+    std::uint32_t SlowdownTimers::GetArmedCount() const {
+        std::uint32_t armed = 0;
+        timers.ForEach([&armed](RE::ActorHandle, std::uint32_t state) { armed += (state & ARMED) != 0; });
+        return armed;
+    }
+}
@@ -0,0 +1,123 @@
+#include "SIGA/SpellIndex.h"
+#include "SIGA/Log.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace SIGA {
+
+    void SpellIndex::BuildAsync() {
+        if (builder.joinable() || IsReady()) {
+            return;
+        }
+
+        // The form array is only read here, on the main thread, while it cannot change
+        auto dataHandler = RE::TESDataHandler::GetSingleton();
+        if (!dataHandler) {
+            logger::error("Spell index: no data handler - BeginCast will walk spell effects");
+            return;
+        }
+        auto& forms = dataHandler->GetFormArray<RE::SpellItem>();
+        std::vector<RE::SpellItem*> spells(forms.begin(), forms.end());
+
+        builder = std::jthread([this, spells = std::move(spells)]() mutable { Build(std::move(spells)); });
+    }
+
+    void SpellIndex::Wait() {
+        if (builder.joinable()) {
+            builder.join();
+        }
+    }
+
+    std::optional<SpellIndex::Info> SpellIndex::Describe(RE::MagicItem* a_spell) const {
+        auto spellItem = a_spell ? a_spell->As<RE::SpellItem>() : nullptr;
+        if (!spellItem) {
+            return std::nullopt;
+        }
+
+        // OPTIMIZATION: One Fibonacci-hashed probe, usually a single cache line, instead of
+        // walking the spell's effects and their base effect forms
+        if (auto table = index.load(std::memory_order_acquire)) {
+            auto formID = spellItem->GetFormID();
+            auto mask = table->size() - 1;
+            for (auto slot = SlotOf(formID, ShiftFor(table->size())); (*table)[slot].formID != 0; slot = (slot + 1) & mask) {
+                const auto& entry = (*table)[slot];
+                if (entry.formID == formID) {
+                    return Info{ static_cast<RE::ActorValue>(entry.school), (entry.flags & MODIFIES_SPEED) != 0, (entry.flags & CONCENTRATION) != 0 };
+                }
+            }
+        }
+        return Scan(spellItem);
+    }
+
+    SpellIndex::Info SpellIndex::Scan(RE::SpellItem* a_spell) {
+        Info info;
+        info.school = a_spell->GetAssociatedSkill();
+        info.concentration = a_spell->GetCastingType() == RE::MagicSystem::CastingType::kConcentration;
+
+        for (auto effect : a_spell->effects) {
+            if (effect && effect->baseEffect) {
+                if (effect->baseEffect->data.primaryAV == RE::ActorValue::kSpeedMult) {
+                    info.modifiesSpeed = true;
+                    break;
+                }
+            }
+        }
+        return info;
+    }
+
+    SpellIndex::Entry SpellIndex::MakeEntry(RE::SpellItem* a_spell) {
+        auto info = Scan(a_spell);
+        std::uint8_t flags = 0;
+        flags |= info.modifiesSpeed ? MODIFIES_SPEED : 0;
+        flags |= info.concentration ? CONCENTRATION : 0;
+        return Entry{ a_spell->GetFormID(), static_cast<std::int16_t>(info.school), flags };
+    }
+
+    void SpellIndex::Build(std::vector<RE::SpellItem*> a_spells) {
+        auto start = std::chrono::steady_clock::now();
+
+        // Each worker scans a contiguous share into its own slice of the result
+        auto entries = std::make_unique<std::vector<Entry>>(a_spells.size());
+        auto workers = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, MAX_WORKERS);
+        auto share = (a_spells.size() + workers - 1) / workers;
+        {
+            std::vector<std::jthread> pool;
+            for (std::size_t begin = 0; begin < a_spells.size(); begin += share) {
+                auto end = std::min(begin + share, a_spells.size());
+                pool.emplace_back([&, begin, end]() {
+                    for (auto i = begin; i < end; ++i) {
+                        (*entries)[i] = a_spells[i] ? MakeEntry(a_spells[i]) : Entry{ 0, 0, 0 };
+                    }
+                });
+            }
+        }
+
+        std::erase_if(*entries, [](const Entry& a_entry) { return a_entry.formID == 0; });
+        std::sort(entries->begin(), entries->end(), [](const Entry& a, const Entry& b) { return a.formID < b.formID; });
+        entries->erase(std::unique(entries->begin(), entries->end(),
+            [](const Entry& a, const Entry& b) { return a.formID == b.formID; }), entries->end());
+
+        // Open addressing at no more than half full keeps probe runs short
+        auto table = std::make_unique<std::vector<Entry>>(std::bit_ceil(std::max<std::size_t>(entries->size() * 2, 16)), Entry{ 0, 0, 0 });
+        auto mask = table->size() - 1;
+        auto shift = ShiftFor(table->size());
+        for (const auto& entry : *entries) {
+            auto slot = SlotOf(entry.formID, shift);
+            while ((*table)[slot].formID != 0) {
+                slot = (slot + 1) & mask;
+            }
+            (*table)[slot] = entry;
+        }
+
+        auto speedSpells = std::count_if(entries->begin(), entries->end(), [](const Entry& a_entry) { return a_entry.flags & MODIFIES_SPEED; });
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logger::info("Spell index: {} spells ({} modify speed), {} KB, built in {:.2f} ms on {} threads",
+            entries->size(), speedSpells, table->size() * sizeof(Entry) / 1024, elapsed, workers);
+
+        built = std::move(table);
+        index.store(built.get(), std::memory_order_release);
+    }
+
+}
@@ -0,0 +1,125 @@
+#include "SIGA/TagClassifier.h"
+#include "SIGA/Log.h"
+
+namespace SIGA {
+
+    TagClassifier* TagClassifier::GetSingleton() {
+        static TagClassifier singleton;
+        return &singleton;
+    }
+
+    namespace {
+        // Statistics only: a plain load/store instead of a locked add keeps the hot path
+        // free of RMW traffic, at the cost of rare lost increments under contention
+        inline void Bump(std::atomic<std::uint64_t>& a_counter) {
+            a_counter.store(a_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    std::uint32_t TagClassifier::SlotFor(std::uintptr_t a_pointer) {
+        // Pool entries are at least 8-byte aligned, so the low bits carry no information
+        auto key = static_cast<std::uint64_t>(a_pointer >> 3);
+        return static_cast<std::uint32_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - CACHE_BITS));
+    }
+
+    std::uintptr_t TagClassifier::Pack(std::uintptr_t a_pointer, AnimEventType a_type) {
+        return a_pointer | (static_cast<std::uintptr_t>(a_type) << TYPE_SHIFT);
+    }
+
+    bool TagClassifier::Initialize() {
+        static_assert(sizeof(std::uintptr_t) == 8, "Tag cache packing assumes 64-bit pointers");
+
+        pointerCacheReady.store(false, std::memory_order_release);
+        for (auto& entry : cache) {
+            entry.store(0, std::memory_order_relaxed);
+        }
+
+        bool success = true;
+        for (std::size_t i = 0; i < AnimEventTags::TAGS.size(); ++i) {
+            auto& tag = AnimEventTags::TAGS[i];
+            internedTags[i] = RE::BSFixedString(tag.name);
+
+            auto pointer = reinterpret_cast<std::uintptr_t>(internedTags[i].data());
+            if (internedTags[i].empty() || (pointer & ~POINTER_MASK) != 0) {
+                logger::warn("Failed to intern animation tag '{}' - using string classification", tag.name);
+                success = false;
+                continue;
+            }
+
+            // The pool interns case-insensitively, so both sheathe spellings may share an entry
+            auto& entry = cache[SlotFor(pointer)];
+            auto existing = entry.load(std::memory_order_relaxed);
+            if (existing != 0 && (existing & POINTER_MASK) != pointer) {
+                SIGA_LOG_DEBUG("Animation tag '{}' collides in the tag cache - it will use the string path", tag.name);
+                continue;
+            }
+            entry.store(Pack(pointer, tag.type), std::memory_order_relaxed);
+        }
+
+        if (!success) {
+            return false;
+        }
+
+        pointerCacheReady.store(true, std::memory_order_release);
+        SIGA_LOG_DEBUG("Tag classifier ready ({} tags interned)", AnimEventTags::TAGS.size());
+        return true;
+    }
+
+    AnimEventType TagClassifier::Classify(const RE::BSFixedString& a_tag) {
+        if (!pointerCacheReady.load(std::memory_order_acquire)) {
+            Bump(stringFallbacks);
+            return AnimEventTags::Classify(a_tag.data(), a_tag.size());
+        }
+
+        auto pointer = reinterpret_cast<std::uintptr_t>(a_tag.data());
+        auto& entry = cache[SlotFor(pointer)];
+        auto cached = entry.load(std::memory_order_relaxed);
+        if ((cached & POINTER_MASK) == pointer && cached != 0) {
+            Bump(pointerHits);
+            return static_cast<AnimEventType>(cached >> TYPE_SHIFT);
+        }
+
+        auto type = AnimEventTags::Classify(a_tag.data(), a_tag.size());
+
+        // Only misses are cached. Our own tags are pinned by internedTags, so a freed
+        // unknown tag's address can never be reused by one of them. A known type here
+        // means an entry we don't hold, which could be freed and recycled; don't cache it.
+        if (type != AnimEventType::Unknown || pointer == 0 || (pointer & ~POINTER_MASK) != 0) {
+            Bump(stringFallbacks);
+            return type;
+        }
+
+        // Never evict a pinned tag of ours for an unknown one
+        if ((cached >> TYPE_SHIFT) == static_cast<std::uintptr_t>(AnimEventType::Unknown)) {
+            entry.store(Pack(pointer, AnimEventType::Unknown), std::memory_order_relaxed);
+        }
+        Bump(cacheFills);
+        return type;
+    }
+
+    TagClassifier::Stats TagClassifier::GetStats() const {
+        Stats stats;
+        stats.pointerHits = pointerHits.load(std::memory_order_relaxed);
+        stats.cacheFills = cacheFills.load(std::memory_order_relaxed);
+        stats.stringFallbacks = stringFallbacks.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void TagClassifier::ResetStats() {
+        pointerHits.store(0, std::memory_order_relaxed);
+        cacheFills.store(0, std::memory_order_relaxed);
+        stringFallbacks.store(0, std::memory_order_relaxed);
+    }
+
+    void TagClassifier::LogStats() const {
+        auto stats = GetStats();
+        auto total = stats.pointerHits + stats.cacheFills + stats.stringFallbacks;
+        if (total == 0) {
+            return;
+        }
+
+        logger::info("Tag classifier: {} events, {:.2f}% pointer hits ({} cache fills, {} string fallbacks)",
+            total, 100.0 * static_cast<double>(stats.pointerHits) / static_cast<double>(total),
+            stats.cacheFills, stats.stringFallbacks);
+    }
+}
@@ -0,0 +1,203 @@
+#include "SIGA/TraceLog.h"
+#include "SIGA/Ticks.h"
+#include <thread>
+
+namespace SIGA {
+    namespace {
+        thread_local void* threadBuffer = nullptr;
+    }
+
+    void TraceLog::SetOutput(std::filesystem::path a_path, OutputFormat a_format) {
+        std::lock_guard<std::mutex> lock(drainMutex);
+        path = std::move(a_path);
+        format = a_format;
+    }
+
+    void TraceLog::SetEnabled(bool a_enabled) {
+        if (enabled.exchange(a_enabled) == a_enabled) {
+            return;
+        }
+        if (a_enabled) {
+            {
+                std::lock_guard<std::mutex> lock(drainMutex);
+                if (!file) {
+                    baseTicks = ReadTicks();
+                    baseTime = std::chrono::steady_clock::now();
+                    microsecondsPerTick = 0.0;
+                }
+            }
+            if (!writer.joinable()) {
+                writer = std::jthread([this](std::stop_token a_stop) { Run(a_stop); });
+            }
+            logger::info("Trace enabled ({})", path.string());
+        }
+        else {
+            // Whatever is buffered goes out now rather than at the next enable
+            Drain();
+            logger::info("Trace disabled");
+        }
+    }
+
+    void TraceLog::Append(Trace::Format a_format, RE::FormID a_formID, std::uint32_t a_value, float a_magnitude) {
+        auto buffer = static_cast<ThreadBuffer*>(threadBuffer);
+        if (!buffer) {
+            buffer = RegisterThread();
+            threadBuffer = buffer;
+        }
+
+        auto head = buffer->head.load(std::memory_order_relaxed);
+        if (head - buffer->tail.load(std::memory_order_acquire) == BUFFER_RECORDS) {
+            // Never wait for the writer; the decoder reports the gap
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer->records[head & (BUFFER_RECORDS - 1)] = {
+            ReadTicks(), a_formID, static_cast<std::uint16_t>(a_format), buffer->thread, a_value, a_magnitude
+        };
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+
+    TraceLog::ThreadBuffer* TraceLog::RegisterThread() {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer->thread = static_cast<std::uint16_t>(buffers.size());
+        buffers.push_back(std::move(buffer));
+        return buffers.back().get();
+    }
+
+    void TraceLog::Drain() {
+        std::lock_guard<std::mutex> lock(drainMutex);
+        if (!file) {
+            if (path.empty()) {
+                return;
+            }
+            std::error_code error;
+            std::filesystem::create_directories(path.parent_path(), error);
+            file = std::fopen(path.string().c_str(), "wb");
+            if (!file) {
+                logger::error("Could not open binary trace {}", path.string());
+                path.clear();
+                return;
+            }
+            if (format == OutputFormat::kChromeJson) {
+                std::fputs("[\n", file);
+            }
+            else {
+                Trace::FileHeader header;
+                std::fwrite(&header, sizeof(header), 1, file);
+                WriteClockSync();
+            }
+        }
+
+        std::vector<ThreadBuffer*> snapshot;
+        {
+            std::lock_guard<std::mutex> buffersLock(buffersMutex);
+            for (auto& buffer : buffers) {
+                snapshot.push_back(buffer.get());
+            }
+        }
+
+        std::uint64_t count = 0;
+        for (auto buffer : snapshot) {
+            auto tail = buffer->tail.load(std::memory_order_relaxed);
+            auto head = buffer->head.load(std::memory_order_acquire);
+            // Up to the end of the ring, then from its start
+            while (tail != head) {
+                auto index = tail & (BUFFER_RECORDS - 1);
+                auto run = std::min(head - tail, BUFFER_RECORDS - index);
+                if (format == OutputFormat::kChromeJson) {
+                    WriteChromeEvents(&buffer->records[index], run);
+                }
+                else {
+                    std::fwrite(&buffer->records[index], sizeof(Trace::Record), run, file);
+                }
+                tail += run;
+                count += run;
+            }
+            buffer->tail.store(tail, std::memory_order_release);
+
+            if (auto lost = buffer->dropped.exchange(0, std::memory_order_relaxed)) {
+                Trace::Record record{ ReadTicks(), 0, static_cast<std::uint16_t>(Trace::Format::kDropped), buffer->thread, lost, 0.0f };
+                if (format == OutputFormat::kChromeJson) {
+                    WriteChromeEvents(&record, 1);
+                }
+                else {
+                    std::fwrite(&record, sizeof(record), 1, file);
+                }
+                dropped += lost;
+            }
+        }
+
+        if (count) {
+            written += count;
+            if (format == OutputFormat::kBinary) {
+                WriteClockSync();
+            }
+            std::fflush(file);
+        }
+    }
+
+    void TraceLog::WriteChromeEvents(const Trace::Record* a_records, std::uint32_t a_count) {
+        if (microsecondsPerTick == 0.0) {
+            // Measured over at least a millisecond; the writer's first drain is later than that
+            auto elapsed = std::chrono::steady_clock::now() - baseTime;
+            if (elapsed < std::chrono::milliseconds(1)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1) - elapsed);
+                elapsed = std::chrono::steady_clock::now() - baseTime;
+            }
+            auto ticks = ReadTicks() - baseTicks;
+            microsecondsPerTick = ticks ? std::chrono::duration<double, std::micro>(elapsed).count() / static_cast<double>(ticks) : 1.0;
+        }
+
+        chromeBuffer.clear();
+        for (std::uint32_t i = 0; i < a_count; ++i) {
+            auto& record = a_records[i];
+            auto ticks = static_cast<double>(static_cast<std::int64_t>(record.timestamp - baseTicks));
+            Trace::AppendChromeEvent(chromeBuffer, record, ticks * microsecondsPerTick);
+        }
+        std::fwrite(chromeBuffer.data(), 1, chromeBuffer.size(), file);
+    }
+
+    void TraceLog::WriteClockSync() {
+        auto wallTime = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        Trace::Record record{ ReadTicks(), static_cast<std::uint32_t>(wallTime), static_cast<std::uint16_t>(Trace::Format::kClockSync), 0,
+            static_cast<std::uint32_t>(wallTime >> 32), 0.0f };
+        std::fwrite(&record, sizeof(record), 1, file);
+    }
+
+    void TraceLog::Run(std::stop_token a_stop) {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!a_stop.stop_requested()) {
+            wake.wait_for(lock, a_stop, WRITE_INTERVAL, [] { return false; });
+            Drain();
+        }
+    }
+
+    void TraceLog::Close() {
+        enabled.store(false);
+        if (writer.joinable()) {
+            writer.request_stop();
+            writer.join();
+        }
+        Drain();
+
+        std::lock_guard<std::mutex> lock(drainMutex);
+        if (file) {
+            if (format == OutputFormat::kChromeJson) {
+                // Every event ends in a comma; an empty object after the last keeps this strict JSON
+                std::fputs("{}]\n", file);
+            }
+            std::fclose(file);
+            file = nullptr;
+        }
+        // Reopening would truncate what was just written
+        path.clear();
+    }
+
+    TraceLog::Stats TraceLog::GetStats() const {
+        std::lock_guard<std::mutex> lock(drainMutex);
+        return { written, dropped };
+    }
+}
@@ -0,0 +1,84 @@
+#include "SIGA/WeaponCache.h"
+#include "SIGA/Log.h"
+
+namespace SIGA {
+
+    WeaponCache::Ranged WeaponCache::GetRanged(RE::Actor* a_actor) {
+        auto seen = entries.Load(a_actor->GetHandle());
+        if (seen & RESOLVED) {
+            return static_cast<Ranged>(seen & TYPE_MASK);
+        }
+        return Resolve(a_actor, seen, true);
+    }
+
+    void WeaponCache::Refresh(RE::Actor* a_actor) {
+        Resolve(a_actor, entries.Load(a_actor->GetHandle()), true);
+    }
+
+    void WeaponCache::Invalidate(RE::ActorHandle a_handle) {
+        entries.Update(a_handle, false, [](std::uint32_t a_state) { return (a_state & ~(RESOLVED | TYPE_MASK)) + GENERATION_STEP; });
+    }
+
+    void WeaponCache::Forget(RE::ActorHandle a_handle) {
+        // A resolve racing this finds the word changed and stores nothing
+        entries.Update(a_handle, false, [](std::uint32_t) { return 0u; });
+        entries.Release(a_handle);
+    }
+
+    void WeaponCache::Clear() {
+        entries.Drain([](RE::ActorHandle, std::uint32_t) {});
+    }
+
+    RE::BSEventNotifyControl WeaponCache::ProcessEvent(
+        const RE::TESEquipEvent* a_event,
+        RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource)
+    {
+        // Any equip can change the ranged weapon: a spell or shield in the left hand takes
+        // a bow off too. Only tracked actors have an entry to mark stale.
+        auto actor = a_event && a_event->actor ? a_event->actor->As<RE::Actor>() : nullptr;
+        if (actor) {
+            Invalidate(actor->GetHandle());
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    std::uint64_t WeaponCache::GetResolveCount() const {
+        return resolves.load(std::memory_order_relaxed);
+    }
+
+    void WeaponCache::ResetResolveCount() {
+        resolves.store(0, std::memory_order_relaxed);
+    }
+
+    WeaponCache::Ranged WeaponCache::QueryEngine(RE::Actor* a_actor) {
+        auto equippedObject = a_actor->GetEquippedObject(false);
+        auto weapon = equippedObject ? equippedObject->As<RE::TESObjectWEAP>() : nullptr;
+        if (!weapon) {
+            return Ranged::kNone;
+        }
+
+        switch (weapon->GetWeaponType()) {
+        case RE::WEAPON_TYPE::kBow:
+            return Ranged::kBow;
+        case RE::WEAPON_TYPE::kCrossbow:
+            return Ranged::kCrossbow;
+        default:
+            return Ranged::kNone;
+        }
+    }
+
+    WeaponCache::Ranged WeaponCache::Resolve(RE::Actor* a_actor, std::uint32_t a_seen, bool a_insert) {
+        resolves.fetch_add(1, std::memory_order_relaxed);
+        auto ranged = QueryEngine(a_actor);
+
+        // Stored only if no equip event moved the entry on while the engine was queried
+        auto result = entries.Update(a_actor->GetHandle(), a_insert, [&](std::uint32_t a_state) {
+            return a_state == a_seen ? (a_state & ~TYPE_MASK) | RESOLVED | static_cast<std::uint32_t>(ranged) : a_state;
+        });
+        if (a_insert && !result) {
+            SIGA_LOG_DEBUG("Weapon cache full - {:X} will query the engine on every draw", a_actor->GetFormID());
+        }
+        return ranged;
+    }
+
+}
@@ -0,0 +1,110 @@
+#include "SIGA/TraceFormat.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// siga_trace_decode [--chrome] <SigaNG.trace>
+// Prints a binary trace from TraceLog as text, one line per record, in time order. With
+// --chrome, prints Chrome trace-event JSON for chrome://tracing or ui.perfetto.dev instead.
+
+namespace {
+    using namespace SIGA;
+
+    std::uint64_t WallTimeOf(const Trace::Record& a_sync) {
+        return static_cast<std::uint64_t>(a_sync.value) << 32 | a_sync.formID;
+    }
+
+    bool IsSync(const Trace::Record& a_record) {
+        return a_record.format == static_cast<std::uint16_t>(Trace::Format::kClockSync);
+    }
+}
+
+int main(int argc, char** argv) {
+    bool chrome = argc == 3 && std::strcmp(argv[1], "--chrome") == 0;
+    if (argc != 2 && !chrome) {
+        std::fprintf(stderr, "usage: %s [--chrome] <SigaNG.trace>\n", argv[0]);
+        return 2;
+    }
+    auto path = argv[argc - 1];
+
+    auto file = std::fopen(path, "rb");
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+
+    Trace::FileHeader expected;
+    Trace::FileHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.version != expected.version || header.recordSize != sizeof(Trace::Record)) {
+        std::fprintf(stderr, "%s is not a SIGA trace (version %u)\n", path, expected.version);
+        std::fclose(file);
+        return 1;
+    }
+
+    std::vector<Trace::Record> records;
+    Trace::Record record;
+    while (std::fread(&record, sizeof(record), 1, file) == 1) {
+        records.push_back(record);
+    }
+    std::fclose(file);
+
+    // Threads are written one buffer at a time; time order interleaves them again
+    std::stable_sort(records.begin(), records.end(),
+        [](const Trace::Record& a, const Trace::Record& b) { return a.timestamp < b.timestamp; });
+
+    // Ticks to wall-clock time, from the first and last clock syncs
+    auto first = std::find_if(records.begin(), records.end(), IsSync);
+    auto last = std::find_if(records.rbegin(), records.rend(), IsSync);
+    if (first == records.end()) {
+        std::fprintf(stderr, "%s has no clock sync record\n", path);
+        return 1;
+    }
+    double nsPerTick = 1.0;
+    if (last->timestamp > first->timestamp) {
+        nsPerTick = static_cast<double>(WallTimeOf(*last) - WallTimeOf(*first)) / static_cast<double>(last->timestamp - first->timestamp);
+    }
+
+    std::uint64_t printed = 0;
+    std::string json;
+    if (chrome) {
+        std::printf("[\n");
+    }
+    for (auto& entry : records) {
+        if (IsSync(entry)) {
+            continue;
+        }
+
+        auto offset = static_cast<double>(static_cast<std::int64_t>(entry.timestamp - first->timestamp)) * nsPerTick;
+        if (chrome) {
+            // Records buffered before the file opened predate the first sync; the timeline
+            // starts at the earliest record instead
+            auto sinceStart = static_cast<double>(entry.timestamp - records.front().timestamp) * nsPerTick;
+            json.clear();
+            Trace::AppendChromeEvent(json, entry, sinceStart / 1000.0);
+            std::fputs(json.c_str(), stdout);
+            ++printed;
+            continue;
+        }
+
+        auto wallTime = static_cast<std::int64_t>(WallTimeOf(*first)) + static_cast<std::int64_t>(offset);
+        auto seconds = static_cast<std::time_t>(wallTime / 1000000000);
+        std::tm local{};
+        localtime_r(&seconds, &local);
+
+        std::printf("[%02d:%02d:%02d.%06lld] [t%u] %s\n", local.tm_hour, local.tm_min, local.tm_sec,
+            static_cast<long long>(wallTime % 1000000000 / 1000), entry.thread, Trace::Describe(entry).c_str());
+        ++printed;
+    }
+    if (chrome) {
+        // Every event ends in a comma; an empty object after the last keeps this strict JSON
+        std::printf("{}]\n");
+    }
+
+    std::fprintf(stderr, "%llu records\n", static_cast<unsigned long long>(printed));
+    return 0;
+}